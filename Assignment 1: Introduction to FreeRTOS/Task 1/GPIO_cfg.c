@@ -3,39 +3,45 @@
 #include "GPIO_cfg.h"
 
 
-PinConfig_t PinConfig_array[] = 
-							{
-								{PORT_0, PIN0, OUTPUT},
-								{PORT_0, PIN1, OUTPUT},
-								{PORT_0, PIN2, OUTPUT},
-								{PORT_0, PIN3, OUTPUT},
-								{PORT_0, PIN4, OUTPUT},
-								{PORT_0, PIN5, OUTPUT},
-								{PORT_0, PIN6, OUTPUT},
-								{PORT_0, PIN7, OUTPUT},
-								{PORT_0, PIN8, OUTPUT},
-								{PORT_0, PIN9, OUTPUT},
-								{PORT_0, PIN10, OUTPUT},
-								{PORT_0, PIN11, OUTPUT},
-								{PORT_0, PIN13, OUTPUT},
-								{PORT_0, PIN14, OUTPUT},
-								{PORT_0, PIN15, OUTPUT},
-								
-								{PORT_1, PIN0, OUTPUT},
-								{PORT_1, PIN1, OUTPUT},
-								{PORT_1, PIN2, OUTPUT},
-								{PORT_1, PIN3, OUTPUT},
-								{PORT_1, PIN4, OUTPUT},
-								{PORT_1, PIN5, OUTPUT},
-								{PORT_1, PIN6, OUTPUT},
-								{PORT_1, PIN7, OUTPUT},
-								{PORT_1, PIN8, OUTPUT},
-								{PORT_1, PIN9, OUTPUT},
-								{PORT_1, PIN10, OUTPUT},
-								{PORT_1, PIN11, OUTPUT},
-								{PORT_1, PIN13, OUTPUT},
-								{PORT_1, PIN14, OUTPUT},
-								{PORT_1, PIN15, OUTPUT},
-							};
+/* One row per pin, every pin of P0.16 to P0.31 and P1.16 to P1.31 exactly
+   once: port, pin, direction, function.  PIN12 of both ports had no entry
+   before the table was checked, so it was left an input from reset and is
+   listed as one. */
+#define GPIO_PIN_TABLE(X) \
+	X(PORT_0, PIN0, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN1, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN2, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN3, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN4, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN5, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN6, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN7, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN8, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN9, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN10, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN11, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN12, INPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN13, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN14, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_0, PIN15, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN0, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN1, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN2, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN3, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN4, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN5, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN6, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN7, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN8, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN9, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN10, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN11, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN12, INPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN13, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN14, OUTPUT, PIN_FUNC_GPIO) \
+	X(PORT_1, PIN15, OUTPUT, PIN_FUNC_GPIO)
 
-uint16_t PinConfig_array_size = sizeof(PinConfig_array)/sizeof(PinConfig_t);
+
+GPIO_CONFIG_CHECK();
+
+const GPIO_Config_t GPIO_Config = GPIO_CONFIG_INIT;
@@ -74,6 +74,9 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Stack of each task, in words. */
+#define mainTASK_STACK_SIZE	( 90 )
+
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -87,7 +90,7 @@ static void prvSetupHardware( void );
 void ledToggle1000ms( void * pvParameters )
 {
     /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
+    pvParameters value in the call to xTaskCreateStatic() below. */
     configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 
     for( ;; )
@@ -111,6 +114,10 @@ void ledToggle1000ms( void * pvParameters )
 
 	/* Handlers declarations */
 	TaskHandle_t ledToggle1000Handler = NULL;
+
+	/* Stack and control block declarations */
+	static StackType_t ledToggle1000Stack[mainTASK_STACK_SIZE];
+	static StaticTask_t ledToggle1000TCB;
 /*
  * Application entry point:
  * Starts all the other tasks, then starts the scheduler. 
@@ -123,13 +130,14 @@ int main( void )
 
     /* Create Tasks here */
 	
-	xTaskCreate(
+	ledToggle1000Handler = xTaskCreateStatic(
 							ledToggle1000ms,       /* Function that implements the task. */
 							"LED Toggle 1000 ms",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
+							mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
 							( void * ) 1,    /* Parameter passed into the task. */
 							1,/* Priority at which the task is created. */
-							&ledToggle1000Handler );      /* Used to pass out the created task's handle. */
+							ledToggle1000Stack,      /* Array to use as the task's stack. */
+							&ledToggle1000TCB );      /* Variable to hold the task's data structure. */
 							
 
 	
@@ -144,8 +152,8 @@ int main( void )
 	these demo application projects then ensure Supervisor mode is used here. */
 	vTaskStartScheduler();
 
-	/* Should never reach here!  If you do then there was not enough heap
-	available for the idle task to be created. */
+	/* Should never reach here!  The idle task is created from static memory,
+	see staticmem.c, so the scheduler cannot fail to start for want of heap. */
 	for( ;; );
 }
 /*-----------------------------------------------------------*/
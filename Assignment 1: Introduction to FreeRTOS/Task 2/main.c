@@ -64,6 +64,7 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "blink.h"
 
 
 /*-----------------------------------------------------------*/
@@ -83,85 +84,14 @@
 static void prvSetupHardware( void );
 /*-----------------------------------------------------------*/
 
-/* "LED 1000ms toggle" task implementation. */
-void ledToggle1000ms( void * pvParameters )
+/* The three LEDs, each on for half of its period: port, pin, period, on time
+   and phase in ticks.  One blink task drives them all. */
+static const xBlinkEntry ledTable[] =
 {
-    /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
-    configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
-
-    for( ;; )
-    {
-        /* Task code goes here. */
-			
-			// turn the LED on
-			GPIO_write(PORT_0, PIN0, PIN_IS_HIGH);
-			
-			// block the task for 1000 ms
-			vTaskDelay(1000);
-			
-			// turn the LED off
-			GPIO_write(PORT_0, PIN0, PIN_IS_LOW);
-			
-			// block the task for 1000 ms
-			vTaskDelay(1000);
-    }
-}
-
-/* "LED toggle 500ms" task implementation. */
-void ledToggle500ms( void * pvParameters )
-{
-    /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
-    configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
-
-    for( ;; )
-    {
-        /* Task code goes here. */
-			
-			// turn the LED on
-			GPIO_write(PORT_0, PIN1, PIN_IS_HIGH);
-			
-			// block the task for 1000 ms
-			vTaskDelay(500);
-			
-			// turn the LED off
-			GPIO_write(PORT_0, PIN1, PIN_IS_LOW);
-			
-			// block the task for 1000 ms
-			vTaskDelay(500);
-    }
-}
-
-/* "LED toggle 100ms" task implementation. */
-void ledToggle100ms( void * pvParameters )
-{
-    /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
-    configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
-
-    for( ;; )
-    {
-        /* Task code goes here. */
-			
-			// turn the LED on
-			GPIO_write(PORT_0, PIN2, PIN_IS_HIGH);
-			
-			// block the task for 1000 ms
-			vTaskDelay(100);
-			
-			// turn the LED off
-			GPIO_write(PORT_0, PIN2, PIN_IS_LOW);
-			
-			// block the task for 1000 ms
-			vTaskDelay(100);
-    }
-}
-
-	/* Handlers declarations */
-	TaskHandle_t ledToggle1000Handler = NULL;
-	TaskHandle_t ledToggle500Handler = NULL;
-	TaskHandle_t ledToggle100Handler = NULL;
+	{ PORT_0, PIN0, 2000, 1000, 0 },
+	{ PORT_0, PIN1, 1000, 500, 0 },
+	{ PORT_0, PIN2, 200, 100, 0 }
+};
 
 /*
  * Application entry point:
@@ -174,33 +104,7 @@ int main( void )
 
 
     /* Create Tasks here */
-	
-	xTaskCreate(
-							ledToggle1000ms,       /* Function that implements the task. */
-							"LED Toggle 1000 ms",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
-							( void * ) 1,    /* Parameter passed into the task. */
-							1,/* Priority at which the task is created. */
-							&ledToggle1000Handler );      /* Used to pass out the created task's handle. */
-							
-	xTaskCreate(
-							ledToggle500ms,       /* Function that implements the task. */
-							"LED Toggle 500 ms",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
-							( void * ) 1,    /* Parameter passed into the task. */
-							2,/* Priority at which the task is created. */
-							&ledToggle500Handler );      /* Used to pass out the created task's handle. */
-							
-	xTaskCreate(
-							ledToggle100ms,       /* Function that implements the task. */
-							"LED Toggle 100 ms",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
-							( void * ) 1,    /* Parameter passed into the task. */
-							3,/* Priority at which the task is created. */
-							&ledToggle100Handler );      /* Used to pass out the created task's handle. */
-
-	
-
+	vStartBlinkTask(ledTable, sizeof(ledTable) / sizeof(ledTable[0]), 1);
 
 	/* Now all the tasks have been started - start the scheduler.
 
@@ -211,8 +115,8 @@ int main( void )
 	these demo application projects then ensure Supervisor mode is used here. */
 	vTaskStartScheduler();
 
-	/* Should never reach here!  If you do then there was not enough heap
-	available for the idle task to be created. */
+	/* Should never reach here!  The idle task is created from static memory,
+	see staticmem.c, so the scheduler cannot fail to start for want of heap. */
 	for( ;; );
 }
 /*-----------------------------------------------------------*/
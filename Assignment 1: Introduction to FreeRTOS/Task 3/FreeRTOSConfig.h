@@ -0,0 +1,109 @@
+/*
+ * FreeRTOS V202012.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <lpc21xx.h>
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE. 
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION		1
+#define configUSE_IDLE_HOOK			0
+#define configUSE_TICK_HOOK			1
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 60000000 )	/* =12.0MHz xtal multiplied by 5 using the PLL. */
+#define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES		( 4 )
+#define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
+#define configMAX_TASK_NAME_LEN		( 8 )
+#define configUSE_TRACE_FACILITY	1
+#define configUSE_16_BIT_TICKS		0
+#define configIDLE_SHOULD_YIELD		1
+
+/* The debouncer samples the buttons from the tick hook, which a stopped tick
+would leave blind, so the tick keeps running through idle. */
+#define configUSE_TICKLESS_IDLE		0
+
+#define configQUEUE_REGISTRY_SIZE 	0
+
+/* The run-time statistics and stack reports share UART1 under a mutex. */
+#define configUSE_MUTEXES			1
+
+/* Tasks, queues and semaphores are all created from static storage, and the
+idle task's comes from Starter_Files_V0/source/staticmem.c, so there is no
+heap to size and running out of RAM is a link error. */
+#define configSUPPORT_STATIC_ALLOCATION		1
+#define configSUPPORT_DYNAMIC_ALLOCATION	0
+
+/* Per task run times in microseconds of Timer1, see
+Starter_Files_V0/header/timebase.h and runstats.h.  The prototypes are
+repeated here for tasks.c, which includes neither header. */
+#define configGENERATE_RUN_TIME_STATS	1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vTimebaseInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ulTimebaseMicros()
+void vTimebaseInit( void );
+unsigned long ulTimebaseMicros( void );
+
+/* Tell the stack monitor how big each task's stack is, see
+Starter_Files_V0/header/stackmon.h.  The kernel paints task stacks as
+configUSE_TRACE_FACILITY is set. */
+#define configRECORD_STACK_HIGH_ADDRESS	1
+#define traceTASK_CREATE( pxNewTCB )		vStackMonitorTaskCreated( ( void * ) ( pxNewTCB ), ( unsigned long ) ( ( pxNewTCB )->pxEndOfStack - ( pxNewTCB )->pxStack ) + 1UL )
+#define traceTASK_DELETE( pxTaskToDelete )	vStackMonitorTaskDeleted( ( void * ) ( pxTaskToDelete ) )
+void vStackMonitorTaskCreated( void *pvTask, unsigned long ulStackWords );
+void vStackMonitorTaskDeleted( void *pvTask );
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 		0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskCleanUpResources	0
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
+
+
+
+#endif /* FREERTOS_CONFIG_H */
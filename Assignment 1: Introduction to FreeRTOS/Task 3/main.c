@@ -59,11 +59,17 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
+#include "semphr.h"
 #include "lpc21xx.h"
 
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "debounce.h"
+#include "gesture.h"
+#include "runstats.h"
+#include "stackmon.h"
 
 
 /*-----------------------------------------------------------*/
@@ -74,6 +80,18 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Stack of each task, in words. */
+#define mainTASK_STACK_SIZE	( 90 )
+
+/* Button edges that can wait for buttonCheck(). */
+#define mainBUTTON_QUEUE_LENGTH	( 4 )
+
+/* How often the run-time statistics are dumped, see runstats.h. */
+#define mainRUN_STATS_PERIOD	( ( TickType_t ) 5000 )
+
+/* How often the stack sizes are reported, see stackmon.h. */
+#define mainSTACK_REPORT_PERIOD	( ( TickType_t ) 30000 )
+
 /* Create enum to track push button status */
 enum pushButtonStates{
 	lessThanTwoSecs,
@@ -83,6 +101,22 @@ enum pushButtonStates{
 
 enum pushButtonStates pushButtonState;
 
+/* Debounced button edges, see buttonCheck() */
+QueueHandle_t buttonEvents = NULL;
+static xDebounceEvent buttonEventStorage[mainBUTTON_QUEUE_LENGTH];
+static StaticQueue_t buttonEventsQueue;
+
+/* Where the run-time statistics and the stack report go.  Both reporters 
+   write to it, and a port takes one writer at a time, so each holds the mutex
+   for the whole of its report. */
+static xComPortHandle statsPort = NULL;
+static SemaphoreHandle_t statsPortMutex = NULL;
+static StaticSemaphore_t statsPortMutexBuffer;
+
+/* Press lengths that separate the three states, and the gap that makes two
+   clicks a double click. */
+static const xGestureThresholds buttonThresholds = { 2000, 4000, 400 };
+
 /*
  * Configure the processor for use with the Keil demo board.  This is very
  * minimal as most of the setup is managed by the settings in the project
@@ -95,7 +129,7 @@ static void prvSetupHardware( void );
 void ledToggle( void * pvParameters )
 {
     /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
+    pvParameters value in the call to xTaskCreateStatic() below. */
     configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 
     for( ;; )
@@ -135,47 +169,50 @@ void ledToggle( void * pvParameters )
 
 void buttonCheck( void * pvParameters ){
 	
-	unsigned char button = 0;
+	xDebounceEvent event;
+	xGesture button;
 	configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
+	vGestureInit(&button, GPIO_PIN_MASK(PIN1), &buttonThresholds);
 	while (1){
-		button = GPIO_read(PORT_0, PIN1);
-		if (button == PIN_IS_LOW){
-			// button is pressed, could be in one of the three possible states
-			vTaskDelay(2000);
-			button = GPIO_read(PORT_0, PIN1);
-			if (button == PIN_IS_LOW){
-				// button is still pressed, could be in second or third state
-				vTaskDelay(2000);
-				button = GPIO_read(PORT_0, PIN1);
-				if (button == PIN_IS_LOW){
-					// button is still pressed after 4 secs, must be in the third state
-					pushButtonState = moreThanFourSecs;
-				}
-				else {
-					// button is released in between 2 and 4 secs, must be in the second state
-					pushButtonState = lessThanFourSecs;
-					// move the task to the blocked state so that the button could save its current state, simplest method to do so is the vTaskDelay()
-					vTaskDelay(2000);
-				}
-			}
-			else {
-				// button is released before 2 seconds, must be in the first state
+		// sleep until the debouncer reports a clean press or release, the button pulls P0.17 low while pressed.
+		xQueueReceive(buttonEvents, &event, portMAX_DELAY);
+		// the press is classified the moment the button is released, the state is kept until the next release
+		switch (eGestureFeed(&button, &event)){
+			case gestureCLICK:
+			case gestureDOUBLE_CLICK:
 				pushButtonState = lessThanTwoSecs;
-				//vTaskDelay(2000);
-			}
-			}
-		else {
-			// button is not pressed at all, considered to be in the first state
-			pushButtonState = lessThanTwoSecs;
-			//vTaskDelay(2000);
+				break;
+
+			case gestureLONG_PRESS:
+				pushButtonState = lessThanFourSecs;
+				break;
+
+			case gestureVERY_LONG_PRESS:
+				pushButtonState = moreThanFourSecs;
+				break;
+
+			default:
+				break;
 		}
 	}
 }
 
+/* The debouncer samples the button from the tick. */
+void vApplicationTickHook( void )
+{
+	vDebounceTick();
+}
+
 	/* Handlers declarations */
 	TaskHandle_t ledToggleHandler = NULL;
 	TaskHandle_t buttonCheckHandler = NULL;
 
+	/* Stack and control block declarations */
+	static StackType_t ledToggleStack[mainTASK_STACK_SIZE];
+	static StaticTask_t ledToggleTCB;
+	static StackType_t buttonCheckStack[mainTASK_STACK_SIZE];
+	static StaticTask_t buttonCheckTCB;
+
 /*
  * Application entry point:
  * Starts all the other tasks, then starts the scheduler. 
@@ -187,24 +224,31 @@ int main( void )
 
 
     /* Create Tasks here */
+	buttonEvents = xQueueCreateStatic(mainBUTTON_QUEUE_LENGTH, sizeof(xDebounceEvent), (uint8_t *) buttonEventStorage, &buttonEventsQueue);
+	xDebounceSubscribe(PORT_0, GPIO_PIN_MASK(PIN1), GPIO_PIN_MASK(PIN1), buttonEvents);
 	
-	xTaskCreate(
+	ledToggleHandler = xTaskCreateStatic(
 							ledToggle,       /* Function that implements the task. */
 							"LED Toggle",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
+							mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
 							( void * ) 1,    /* Parameter passed into the task. */
 							1,/* Priority at which the task is created. */
-							&ledToggleHandler
-							);      /* Used to pass out the created task's handle. */
+							ledToggleStack,      /* Array to use as the task's stack. */
+							&ledToggleTCB );      /* Variable to hold the task's data structure. */
 							
-	xTaskCreate(
+	buttonCheckHandler = xTaskCreateStatic(
 							buttonCheck,       /* Function that implements the task. */
 							"button Check",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
+							mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
 							( void * ) 1,    /* Parameter passed into the task. */
 							2,/* Priority at which the task is created. */
-							&buttonCheckHandler
-							);      /* Used to pass out the created task's handle. */						
+							buttonCheckStack,      /* Array to use as the task's stack. */
+							&buttonCheckTCB );      /* Variable to hold the task's data structure. */
+
+	/* Above the application tasks, so a task that never blocks still shows up in the table. */
+	statsPortMutex = xSemaphoreCreateMutexStatic(&statsPortMutexBuffer);
+	vStartRunTimeStatsTask(statsPort, statsPortMutex, 3, mainRUN_STATS_PERIOD);
+	vStartStackMonitorTask(statsPort, statsPortMutex, 3, mainSTACK_REPORT_PERIOD);
 							
 
 	
@@ -219,8 +263,8 @@ int main( void )
 	these demo application projects then ensure Supervisor mode is used here. */
 	vTaskStartScheduler();
 
-	/* Should never reach here!  If you do then there was not enough heap
-	available for the idle task to be created. */
+	/* Should never reach here!  The idle task is created from static memory,
+	see staticmem.c, so the scheduler cannot fail to start for want of heap. */
 	for( ;; );
 }
 /*-----------------------------------------------------------*/
@@ -231,7 +275,7 @@ static void prvSetupHardware( void )
 	setup is managed by the settings in the project file. */
 
 	/* Configure UART */
-	xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
+	statsPort = xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
 
 	/* Configure GPIO */
 	GPIO_init();
@@ -44,19 +44,46 @@
 
 #define configUSE_PREEMPTION		0
 #define configUSE_IDLE_HOOK			0
-#define configUSE_TICK_HOOK			0
+#define configUSE_TICK_HOOK			1
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 60000000 )	/* =12.0MHz xtal multiplied by 5 using the PLL. */
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
 #define configMAX_TASK_NAME_LEN		( 8 )
-#define configUSE_TRACE_FACILITY	0
+#define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 
+/* The debouncer samples the buttons from the tick hook, which a stopped tick
+would leave blind, so the tick keeps running through idle. */
+#define configUSE_TICKLESS_IDLE		0
+
 #define configQUEUE_REGISTRY_SIZE 	0
 
+/* Tasks, queues and semaphores are all created from static storage, and the
+idle task's comes from Starter_Files_V0/source/staticmem.c, so there is no
+heap to size and running out of RAM is a link error. */
+#define configSUPPORT_STATIC_ALLOCATION		1
+#define configSUPPORT_DYNAMIC_ALLOCATION	0
+
+/* Per task run times in microseconds of Timer1, see
+Starter_Files_V0/header/timebase.h and runstats.h.  The prototypes are
+repeated here for tasks.c, which includes neither header. */
+#define configGENERATE_RUN_TIME_STATS	1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vTimebaseInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ulTimebaseMicros()
+void vTimebaseInit( void );
+unsigned long ulTimebaseMicros( void );
+
+/* Tell the stack monitor how big each task's stack is, see
+Starter_Files_V0/header/stackmon.h.  The kernel paints task stacks as
+configUSE_TRACE_FACILITY is set. */
+#define configRECORD_STACK_HIGH_ADDRESS	1
+#define traceTASK_CREATE( pxNewTCB )		vStackMonitorTaskCreated( ( void * ) ( pxNewTCB ), ( unsigned long ) ( ( pxNewTCB )->pxEndOfStack - ( pxNewTCB )->pxStack ) + 1UL )
+#define traceTASK_DELETE( pxTaskToDelete )	vStackMonitorTaskDeleted( ( void * ) ( pxTaskToDelete ) )
+void vStackMonitorTaskCreated( void *pvTask, unsigned long ulStackWords );
+void vStackMonitorTaskDeleted( void *pvTask );
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
@@ -71,6 +98,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
 
 
 
@@ -65,6 +65,7 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "debounce.h"
 
 
 /*-----------------------------------------------------------*/
@@ -75,6 +76,12 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Stack of each task, in words. */
+#define mainTASK_STACK_SIZE	( 90 )
+
+/* Button edges that can wait for buttonCheck(). */
+#define mainBUTTON_QUEUE_LENGTH	( 4 )
+
 /*
  * Configure the processor for use with the Keil demo board.  This is very
  * minimal as most of the setup is managed by the settings in the project
@@ -87,21 +94,30 @@ static void prvSetupHardware( void );
 TaskHandle_t ledToggleHandler = NULL;
 TaskHandle_t buttonCheckHandler = NULL;
 SemaphoreHandle_t xSemaphore = NULL;
+QueueHandle_t buttonEvents = NULL;
+
+/* Stack, control block and storage declarations */
+static StackType_t ledToggleStack[mainTASK_STACK_SIZE];
+static StaticTask_t ledToggleTCB;
+static StackType_t buttonCheckStack[mainTASK_STACK_SIZE];
+static StaticTask_t buttonCheckTCB;
+static StaticSemaphore_t xSemaphoreBuffer;
+static xDebounceEvent buttonEventStorage[mainBUTTON_QUEUE_LENGTH];
+static StaticQueue_t buttonEventsQueue;
 
 
 /* "LED toggle" task implementation. */
 void ledToggle( void * pvParameters )
 {
     /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
+    pvParameters value in the call to xTaskCreateStatic() below. */
     configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 
     for( ;; )
     {
       /* Task code goes here. */
-			// enter the task code at the first time, and then only enter when the semaphore is taken by the "button" task
-			// Note: we can either take or give the semaphore in the following statement as it is binary semaphore.
-			if (xSemaphoreTake(xSemaphore, 0) == pdTRUE){
+			// block until the "button" task gives the semaphore, no CPU is used while waiting.
+			if (xSemaphoreTake(xSemaphore, portMAX_DELAY) == pdTRUE){
 				if (GPIO_read(PORT_0, PIN0) == PIN_IS_LOW){
 					GPIO_write(PORT_0, PIN0, PIN_IS_HIGH);
 				}
@@ -110,27 +126,31 @@ void ledToggle( void * pvParameters )
 					GPIO_write(PORT_0, PIN0, PIN_IS_LOW);
 				}
 			}
-				vTaskDelay(1);
 		}
 }
 
 
 void buttonCheck( void * pvParameters ){
 	
-	unsigned char buttonState = 0;
+	xDebounceEvent event;
 	configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 	while (1){
-		buttonState = GPIO_read(PORT_0, PIN1);
-		if (buttonState == PIN_IS_LOW){
-			// button is pressed, will wait until button is released
-			while (GPIO_read(PORT_0, PIN1) != PIN_IS_HIGH);
+		// sleep until the debouncer reports a clean edge of the button (P0.17, low while pressed), a release toggles the LED.
+		xQueueReceive(buttonEvents, &event, portMAX_DELAY);
+		if (event.ulReleased != 0){
 			xSemaphoreGive(xSemaphore);
 		}
-		vTaskDelay(1);
 	}
 }
 
 
+/* The debouncer samples the button from the tick. */
+void vApplicationTickHook( void )
+{
+	vDebounceTick();
+}
+
+
 
 
 /*
@@ -143,25 +163,27 @@ int main( void )
 	prvSetupHardware();
 
 	/* Create Tasks here */
-	xSemaphore = xSemaphoreCreateBinary();
+	xSemaphore = xSemaphoreCreateBinaryStatic(&xSemaphoreBuffer);
+	buttonEvents = xQueueCreateStatic(mainBUTTON_QUEUE_LENGTH, sizeof(xDebounceEvent), (uint8_t *) buttonEventStorage, &buttonEventsQueue);
+	xDebounceSubscribe(PORT_0, GPIO_PIN_MASK(PIN1), GPIO_PIN_MASK(PIN1), buttonEvents);
 
-	xTaskCreate(
+	ledToggleHandler = xTaskCreateStatic(
 							ledToggle,       /* Function that implements the task. */
 							"LED Toggle",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
+							mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
 							( void * ) 1,    /* Parameter passed into the task. */
 							1,/* Priority at which the task is created. */
-							&ledToggleHandler
-							);      /* Used to pass out the created task's handle. */
+							ledToggleStack,      /* Array to use as the task's stack. */
+							&ledToggleTCB );      /* Variable to hold the task's data structure. */
 							
-	xTaskCreate(
+	buttonCheckHandler = xTaskCreateStatic(
 							buttonCheck,       /* Function that implements the task. */
 							"button Check",          /* Text name for the task. */
-							90,      /* Stack size in words, not bytes. */
+							mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
 							( void * ) 1,    /* Parameter passed into the task. */
 							1,/* Priority at which the task is created. */
-							&buttonCheckHandler
-							);      /* Used to pass out the created task's handle. */						
+							buttonCheckStack,      /* Array to use as the task's stack. */
+							&buttonCheckTCB );      /* Variable to hold the task's data structure. */
 							
 
 	
@@ -176,8 +198,8 @@ int main( void )
 	these demo application projects then ensure Supervisor mode is used here. */
 	vTaskStartScheduler();
 
-	/* Should never reach here!  If you do then there was not enough heap
-	available for the idle task to be created. */
+	/* Should never reach here!  The idle task is created from static memory,
+	see staticmem.c, so the scheduler cannot fail to start for want of heap. */
 	for( ;; );
 }
 /*-----------------------------------------------------------*/
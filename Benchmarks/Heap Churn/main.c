@@ -0,0 +1,123 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* 
+	NOTE : Tasks run in system mode and the scheduler runs in Supervisor mode.
+	The processor MUST be in supervisor mode when vTaskStartScheduler is 
+	called.  The demo applications included in the FreeRTOS.org download switch
+	to supervisor mode prior to main being called.  If you are not using one of
+	these demo application projects then ensure Supervisor mode is used.
+*/
+
+/*
+ * Heap benchmark firmware.  Build it as the assignments are built, with this
+ * file in place of Starter_Files_V0/source/main.c and the FreeRTOSConfig.h
+ * beside it in place of the project's.  The results come out of UART1 every 
+ * few seconds, see heapbench.c for the format.  As it is, the heap is the 
+ * pool heap of poolheap.c.  To compare heap_2, define poolheapENABLE as 0 in
+ * FreeRTOSConfig.h and add Source/portable/MemMang/heap_2.c to the project.
+ * The host builds are "make hbench" and "make hbench-heap2" in the host 
+ * directory.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+#include "timebase.h"
+#include "heapbench.h"
+
+
+/*-----------------------------------------------------------*/
+
+/* Constants to setup I/O and processor. */
+#define mainBUS_CLK_FULL	( ( unsigned char ) 0x01 )
+
+/* Constants for the ComTest demo application tasks. */
+#define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
+
+/* The benchmark task's priority.  The tasks it creates have the idle one. */
+#define mainBENCH_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+/*
+ * Configure the processor for use with the Keil demo board.  This is very
+ * minimal as most of the setup is managed by the settings in the project
+ * file.
+ */
+static xComPortHandle prvSetupHardware( void );
+/*-----------------------------------------------------------*/
+
+/*
+ * Application entry point:
+ * Starts the benchmark task, then starts the scheduler. 
+ */
+int main( void )
+{
+xComPortHandle xPort;
+
+	/* Setup the hardware for use with the Keil demo board. */
+	xPort = prvSetupHardware();
+
+	vStartHeapBenchTask( xPort, mainBENCH_PRIORITY );
+
+	/* Now all the tasks have been started - start the scheduler.
+
+	NOTE : Tasks run in system mode and the scheduler runs in Supervisor mode.
+	The processor MUST be in supervisor mode when vTaskStartScheduler is 
+	called.  The demo applications included in the FreeRTOS.org download switch
+	to supervisor mode prior to main being called.  If you are not using one of
+	these demo application projects then ensure Supervisor mode is used here. */
+	vTaskStartScheduler();
+
+	/* Should never reach here!  If you do then there was not enough heap
+	available for the idle task to be created. */
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static xComPortHandle prvSetupHardware( void )
+{
+xComPortHandle xPort;
+
+	/* Perform the hardware setup required.  This is minimal as most of the
+	setup is managed by the settings in the project file. */
+
+	/* Configure UART */
+	xPort = xSerialPortInitMinimal( mainCOM_TEST_BAUD_RATE );
+
+	/* Setup the peripheral bus to be the same as the PLL output. */
+	VPBDIV = mainBUS_CLK_FULL;
+
+	/* Timer1 counts at the peripheral clock, so is started after VPBDIV. */
+	vTimebaseInit();
+
+	return xPort;
+}
+/*-----------------------------------------------------------*/
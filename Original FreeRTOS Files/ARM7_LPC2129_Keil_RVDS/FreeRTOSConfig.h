@@ -49,14 +49,45 @@
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
 #define configMAX_TASK_NAME_LEN		( 8 )
-#define configUSE_TRACE_FACILITY	0
+#define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 
+/* Stop the tick while the idle task runs, see Starter_Files_V0/header/
+lowpower.h.  The kernel calls it from tasks.c, which does not include
+lowpower.h, so the prototype is repeated here.  TickType_t is not defined yet,
+but with 32 bit ticks it is the uint32_t FreeRTOS.h has from stdint.h. */
+#define configUSE_TICKLESS_IDLE		2
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vLowPowerSleep( xExpectedIdleTime )
+void vLowPowerSleep( uint32_t xExpectedIdleTime );
+
 #define configQUEUE_REGISTRY_SIZE 	0
 
+/* Tasks, queues and semaphores are all created from static storage, and the
+idle task's comes from Starter_Files_V0/source/staticmem.c, so there is no
+heap to size and running out of RAM is a link error. */
+#define configSUPPORT_STATIC_ALLOCATION		1
+#define configSUPPORT_DYNAMIC_ALLOCATION	0
+
+/* Per task run times in microseconds of Timer1, see
+Starter_Files_V0/header/timebase.h and runstats.h.  The prototypes are
+repeated here for tasks.c, which includes neither header. */
+#define configGENERATE_RUN_TIME_STATS	1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vTimebaseInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ulTimebaseMicros()
+void vTimebaseInit( void );
+unsigned long ulTimebaseMicros( void );
+
+/* Tell the stack monitor how big each task's stack is, see
+Starter_Files_V0/header/stackmon.h.  The kernel paints task stacks as
+configUSE_TRACE_FACILITY is set. */
+#define configRECORD_STACK_HIGH_ADDRESS	1
+#define traceTASK_CREATE( pxNewTCB )		vStackMonitorTaskCreated( ( void * ) ( pxNewTCB ), ( unsigned long ) ( ( pxNewTCB )->pxEndOfStack - ( pxNewTCB )->pxStack ) + 1UL )
+#define traceTASK_DELETE( pxTaskToDelete )	vStackMonitorTaskDeleted( ( void * ) ( pxTaskToDelete ) )
+void vStackMonitorTaskCreated( void *pvTask, unsigned long ulStackWords );
+void vStackMonitorTaskDeleted( void *pvTask );
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
@@ -71,6 +102,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
 
 
 
@@ -3,6 +3,8 @@
 #ifndef GPIO_H_
 #define GPIO_H_
 
+#include <stdint.h>
+
 /************* Type def section ************/
 
 /* Port data type */
@@ -49,6 +51,10 @@ typedef enum
 
 }pinState_t;
 
+/* Mask of a pin for GPIO_writeMask() and GPIO_readPort(), the pinX_t values
+   are already bit positions in the port registers. */
+#define GPIO_PIN_MASK(pinNum)	((uint32_t)1 << (pinNum))
+
 
 /************ Function declaration section ***********/
 
@@ -56,6 +62,15 @@ extern void GPIO_init(void);
 extern pinState_t GPIO_read(portX_t PortName, pinX_t pinNum);
 extern void GPIO_write(portX_t PortName, pinX_t PinNum, pinState_t pinState);
 
+/* Drives every pin in setMask high and every pin in clrMask low, with one
+   store to IOSETx and one to IOCLRx (none for an empty mask).  A pin in both
+   masks ends up low.  Pins outside both masks are not touched. */
+extern void GPIO_writeMask(portX_t PortName, uint32_t setMask, uint32_t clrMask);
+
+/* Returns the whole IOPINx register from one load, test pins with
+   GPIO_PIN_MASK(). */
+extern uint32_t GPIO_readPort(portX_t PortName);
+
 
 
 #endif /* DIO_MCAL_INC_DIO_H_ */
@@ -1,21 +1,69 @@
-
-
 #ifndef GPIO_CFG_H_
 #define GPIO_CFG_H_
 
 /************* Type def section ************/
 
+/* Pin function, the PINSEL1 field value for P0.16 to P0.31. */
+typedef enum
+{
+	PIN_FUNC_GPIO,
+	PIN_FUNC_ALT1,
+	PIN_FUNC_ALT2,
+	PIN_FUNC_ALT3
+
+}pinFunc_t;
+
+/* The pin table folded down to the values GPIO_init() stores. */
 typedef struct
 {
-	portX_t Port;
-	pinX_t Pin;
-	pinDir_t Direction;
-	
-}PinConfig_t;
+	uint32_t Dir0;		/* IODIR0 bits of P0.16 to P0.31. */
+	uint32_t Dir1;		/* IODIR1 bits of P1.16 to P1.31. */
+	uint32_t PinSel1;	/* PINSEL1, the functions of P0.16 to P0.31. */
+
+}GPIO_Config_t;
+
+
+/************ Table reduction section ***********/
+
+/* Each GPIO_cfg.c lists every pin once as
+
+       #define GPIO_PIN_TABLE(X) \
+           X(PORT_0, PIN0, OUTPUT, PIN_FUNC_GPIO) \
+           ...
+
+   then defines GPIO_Config with GPIO_CONFIG_INIT and checks the table with
+   GPIO_CONFIG_CHECK().  The macros below expand every row into a constant
+   term, so the table itself never reaches the image.  Only P0.16 to P0.31
+   have a PINSEL1 field, port 1 pins must stay PIN_FUNC_GPIO. */
+#define GPIO_CFG_PORT_MASK		((uint32_t)0xFFFF0000)
+
+#define GPIO_CFG_DIR0(port, pin, dir, func)		| (((PORT_0 == (port)) && (OUTPUT == (dir))) ? GPIO_PIN_MASK(pin) : 0)
+#define GPIO_CFG_DIR1(port, pin, dir, func)		| (((PORT_1 == (port)) && (OUTPUT == (dir))) ? GPIO_PIN_MASK(pin) : 0)
+#define GPIO_CFG_USED0(port, pin, dir, func)	| ((PORT_0 == (port)) ? GPIO_PIN_MASK(pin) : 0)
+#define GPIO_CFG_USED1(port, pin, dir, func)	| ((PORT_1 == (port)) ? GPIO_PIN_MASK(pin) : 0)
+#define GPIO_CFG_COUNT0(port, pin, dir, func)	+ ((PORT_0 == (port)) ? 1 : 0)
+#define GPIO_CFG_COUNT1(port, pin, dir, func)	+ ((PORT_1 == (port)) ? 1 : 0)
+#define GPIO_CFG_SEL1(port, pin, dir, func)		| ((PORT_0 == (port)) ? ((uint32_t)(func) << (((pin) - PIN0) * 2)) : 0)
+#define GPIO_CFG_ALT1(port, pin, dir, func)		| ((PORT_1 == (port)) ? (uint32_t)(func) : 0)
+
+#define GPIO_CONFIG_INIT											\
+	{																\
+		0 GPIO_PIN_TABLE(GPIO_CFG_DIR0),							\
+		0 GPIO_PIN_TABLE(GPIO_CFG_DIR1),							\
+		0 GPIO_PIN_TABLE(GPIO_CFG_SEL1)								\
+	}
+
+/* Sixteen rows per port that between them name all sixteen pins leave no
+   room for a duplicate or a gap. */
+#define GPIO_CONFIG_CHECK()																									\
+	typedef char GPIO_PIN_TABLE_port0_needs_16_rows[((0 GPIO_PIN_TABLE(GPIO_CFG_COUNT0)) == 16) ? 1 : -1];					\
+	typedef char GPIO_PIN_TABLE_port1_needs_16_rows[((0 GPIO_PIN_TABLE(GPIO_CFG_COUNT1)) == 16) ? 1 : -1];					\
+	typedef char GPIO_PIN_TABLE_port0_pin_missing[((0 GPIO_PIN_TABLE(GPIO_CFG_USED0)) == GPIO_CFG_PORT_MASK) ? 1 : -1];		\
+	typedef char GPIO_PIN_TABLE_port1_pin_missing[((0 GPIO_PIN_TABLE(GPIO_CFG_USED1)) == GPIO_CFG_PORT_MASK) ? 1 : -1];		\
+	typedef char GPIO_PIN_TABLE_port1_has_no_PINSEL[((0 GPIO_PIN_TABLE(GPIO_CFG_ALT1)) == 0) ? 1 : -1]
 
 
-extern PinConfig_t PinConfig_array[];
-extern uint16_t PinConfig_array_size;
+extern const GPIO_Config_t GPIO_Config;
 
 
-#endif 
+#endif
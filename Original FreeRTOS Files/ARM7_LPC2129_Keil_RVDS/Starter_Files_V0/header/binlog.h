@@ -0,0 +1,71 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef BINLOG_H
+#define BINLOG_H
+
+#include "binlog_ids.h"
+
+/* The most 32 bit arguments a single record can carry. */
+#define binlogMAX_ARGS		4
+
+#define binlogID_ENTRY( eID, pcFormat )		eID,
+
+typedef enum
+{
+	binlogMESSAGES( binlogID_ENTRY )
+	binlogNUM_MESSAGES
+} eBinLogID;
+
+/*
+ * Record a message.  Only the ID, the tick count and the raw arguments are 
+ * stored; the drain task frames them onto the serial port later and the host 
+ * turns them into text.  The task versions may be called from any task, the 
+ * FromISR versions from an ISR.  None of them block.  A record that finds the 
+ * buffer full is dropped and counted.
+ */
+#define binLOG0( eID )								vBinLog( ( eID ), 0, 0UL, 0UL, 0UL, 0UL )
+#define binLOG1( eID, a )							vBinLog( ( eID ), 1, ( unsigned long ) ( a ), 0UL, 0UL, 0UL )
+#define binLOG2( eID, a, b )						vBinLog( ( eID ), 2, ( unsigned long ) ( a ), ( unsigned long ) ( b ), 0UL, 0UL )
+#define binLOG3( eID, a, b, c )						vBinLog( ( eID ), 3, ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), 0UL )
+#define binLOG4( eID, a, b, c, d )					vBinLog( ( eID ), 4, ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), ( unsigned long ) ( d ) )
+
+#define binLOG0_FROM_ISR( eID )						vBinLogFromISR( ( eID ), 0, 0UL, 0UL, 0UL, 0UL )
+#define binLOG1_FROM_ISR( eID, a )					vBinLogFromISR( ( eID ), 1, ( unsigned long ) ( a ), 0UL, 0UL, 0UL )
+#define binLOG2_FROM_ISR( eID, a, b )				vBinLogFromISR( ( eID ), 2, ( unsigned long ) ( a ), ( unsigned long ) ( b ), 0UL, 0UL )
+#define binLOG3_FROM_ISR( eID, a, b, c )			vBinLogFromISR( ( eID ), 3, ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), 0UL )
+#define binLOG4_FROM_ISR( eID, a, b, c, d )			vBinLogFromISR( ( eID ), 4, ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), ( unsigned long ) ( d ) )
+
+void vBinLog( eBinLogID eID, unsigned portBASE_TYPE uxArgs, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+void vBinLogFromISR( eBinLogID eID, unsigned portBASE_TYPE uxArgs, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+
+/* Creates the task that sends the buffered records to pxPort. */
+void vStartBinLogTask( xComPortHandle pxPort, unsigned portBASE_TYPE uxPriority );
+
+#endif
+
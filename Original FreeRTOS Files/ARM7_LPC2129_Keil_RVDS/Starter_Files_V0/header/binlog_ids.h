@@ -0,0 +1,53 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef BINLOG_IDS_H
+#define BINLOG_IDS_H
+
+/*
+ * The log message table.  Each row gives the ID used at the call site and the
+ * printf style format the host decoder applies to the record's arguments.  The
+ * format strings are never compiled into the target, tools/binlog_decode.py 
+ * reads them from this file, so the decoder must be given the copy of this file
+ * the target was built with.
+ *
+ * Only %d, %u, %x, %X and %c are understood, each consuming one 32 bit 
+ * argument, and a record carries at most binlogMAX_ARGS of them.  Rows can be
+ * added anywhere except above binlogDROPPED, whose ID must stay 0.  Keep one
+ * row per line so the decoder can find them.
+ */
+#define binlogMESSAGES( X )																\
+	X( binlogDROPPED,			"binlog: %u records dropped" )							\
+	X( binlogBOOT,				"boot: heap free %u bytes" )							\
+	X( binlogTASK_STARTED,		"task %u started at priority %u" )						\
+	X( binlogSERIAL_STATS,		"serial: rx %u dropped %u overruns %u framing %u" )		\
+	X( binlogBUTTON,			"button on P%u.%u now %u" )								\
+	X( binlogASSERT,			"assert failed at line %u" )
+
+#endif
+
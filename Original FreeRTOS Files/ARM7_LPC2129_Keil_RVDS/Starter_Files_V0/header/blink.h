@@ -0,0 +1,63 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef BLINK_H
+#define BLINK_H
+
+/* One LED.  Over every xPeriod ticks the pin is high for the first xOnTicks
+and low for the rest, with the periods counted from tick xPhase.  xOnTicks of
+0 holds the pin low and xOnTicks of xPeriod or more holds it high. */
+typedef struct
+{
+	portX_t ePort;
+	pinX_t ePin;
+	TickType_t xPeriod;
+	TickType_t xOnTicks;
+	TickType_t xPhase;
+} xBlinkEntry;
+
+/* The most entries one table can have. */
+#define blinkMAX_ENTRIES			( 8 )
+
+/* Drives every LED in pxTable at uxPriority.  An LED on a pin with a PWM 
+output is handed to the PWM block, see pwm.h, and costs the processor nothing
+while it blinks; xPhase is not kept for those, they count from when they were
+handed over.  The rest are driven from one task.  The table is copied, so it
+can be const and live in flash. */
+void vStartBlinkTask( const xBlinkEntry *pxTable, unsigned portBASE_TYPE uxEntries, unsigned portBASE_TYPE uxPriority );
+
+/* Changes the rate and duty of entry uxEntry of the table, moving it between
+the PWM block and the task as needed.  Takes effect from the next period on a
+pin the PWM block drives and straight away on any other.  Call from a task 
+once vStartBlinkTask() has run. */
+void vBlinkSet( unsigned portBASE_TYPE uxEntry, TickType_t xPeriod, TickType_t xOnTicks );
+
+/* pdTRUE if the PWM block, rather than the task, is driving entry uxEntry. */
+portBASE_TYPE xBlinkInHardware( unsigned portBASE_TYPE uxEntry );
+
+#endif
+
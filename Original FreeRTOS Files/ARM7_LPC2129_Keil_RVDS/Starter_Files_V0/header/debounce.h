@@ -0,0 +1,62 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/* Inputs are sampled every debounceSAMPLE_TICKS ticks, and a pin has to read
+the same debounceSAMPLES times in a row before its change is believed. */
+#define debounceSAMPLE_TICKS		( ( TickType_t ) 5 / portTICK_PERIOD_MS )
+#define debounceSAMPLES				( 4 )
+
+/* What a subscriber's queue receives.  Masks are in IOPIN bit positions, use
+GPIO_PIN_MASK() to test them. */
+typedef struct
+{
+	TickType_t xTime;			/* The tick count of the sample that settled the change. */
+	portX_t ePort;
+	unsigned long ulPressed;	/* Subscribed pins that have just gone active. */
+	unsigned long ulReleased;	/* Subscribed pins that have just gone inactive. */
+	unsigned long ulState;		/* The whole port, debounced. */
+} xDebounceEvent;
+
+/* Sends an xDebounceEvent to xQueue each time a pin in ulMask settles at a
+new level.  Pins in ulActiveLow are pressed when low, the others when high.
+Events that do not fit in the queue are counted, see ulDebounceDropped().  
+Returns pdFAIL once debounceMAX_SUBSCRIBERS are subscribed. */
+signed portBASE_TYPE xDebounceSubscribe( portX_t ePort, unsigned long ulMask, unsigned long ulActiveLow, QueueHandle_t xQueue );
+
+/* The debounced level of every pin on the port. */
+unsigned long ulDebounceState( portX_t ePort );
+unsigned long ulDebounceDropped( void );
+
+/* Call from vApplicationTickHook(), which needs configUSE_TICK_HOOK set to 1.
+Samples and debounces both ports every debounceSAMPLE_TICKS calls. */
+void vDebounceTick( void );
+
+#endif
+
@@ -0,0 +1,74 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef EINT_H
+#define EINT_H
+
+/* External interrupt lines, on VIC channels 14 to 17.  The pin that carries
+each line is picked by its PINSEL function in GPIO_cfg.c, e.g. EINT3 is 
+PIN_FUNC_ALT3 of P0.20 (PIN4). */
+typedef enum
+{
+	eintEINT0,
+	eintEINT1,
+	eintEINT2,
+	eintEINT3
+} eEintLine;
+
+typedef enum
+{
+	eintFALLING_EDGE,
+	eintRISING_EDGE,
+	eintLOW_LEVEL,
+	eintHIGH_LEVEL
+} eEintTrigger;
+
+/* What a queue opened with xEintOpen() receives. */
+typedef struct
+{
+	TickType_t xTime;			/* The tick count when the interrupt was taken. */
+	unsigned char ucLine;		/* eEintLine. */
+} xEintEvent;
+
+/* Starts delivering the line's interrupts.  Each one sets bit ( 1 << eLine )
+in xTask's notification value (wait with xTaskNotifyWait()) if xTask is not
+NULL, and sends an xEintEvent to xQueue if xQueue is not NULL.  Events that do
+not fit in the queue are counted, see ulEintDropped().  A level triggered line
+is masked after each interrupt until vEintArm() is called, once whatever 
+holds the level has been dealt with.  An open line is set in EXTWAKE, so it
+can wake the processor from power down.  Returns pdFAIL if the line is 
+already open. */
+signed portBASE_TYPE xEintOpen( eEintLine eLine, eEintTrigger eTrigger, TaskHandle_t xTask, QueueHandle_t xQueue );
+void vEintClose( eEintLine eLine );
+void vEintArm( eEintLine eLine );
+unsigned long ulEintDropped( eEintLine eLine );
+
+/* Shared by the four lines, entered through vEint_ISREntry in eintISR.s. */
+void vEint_ISRHandler( void );
+
+#endif
+
@@ -0,0 +1,74 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+/* What a press turned out to be, known as the button is released. */
+typedef enum
+{
+	gestureNONE,				/* Not a release, or not the pin being watched. */
+	gestureCLICK,				/* Released before xLongPress. */
+	gestureDOUBLE_CLICK,		/* A click pressed within xDoubleClickGap of the last click's release. */
+	gestureLONG_PRESS,			/* Held for at least xLongPress. */
+	gestureVERY_LONG_PRESS		/* Held for at least xVeryLongPress. */
+} eGesture;
+
+typedef struct
+{
+	TickType_t xLongPress;
+	TickType_t xVeryLongPress;
+	TickType_t xDoubleClickGap;
+} xGestureThresholds;
+
+/* The state of one button.  Belongs to the one task that feeds it. */
+typedef struct
+{
+	const xGestureThresholds *pxThresholds;
+	unsigned long ulPin;			/* GPIO_PIN_MASK() of the button. */
+	TickType_t xPressedAt;
+	TickType_t xClickReleasedAt;
+	TickType_t xHeld;				/* How long the last press was held. */
+	portBASE_TYPE xPressed;
+	portBASE_TYPE xClickPending;	/* The last press was a click that could start a double click. */
+} xGesture;
+
+/* Watches the pin ulPin of the events later fed in.  pxThresholds is kept,
+not copied. */
+void vGestureInit( xGesture *pxGesture, unsigned long ulPin, const xGestureThresholds *pxThresholds );
+
+/* Feeds one event from the debouncer, see debounce.h, and classifies the
+press on its release from the timestamps of the two edges.  A click that
+turns out to be the first half of a double click has already been returned
+as gestureCLICK by then.  Returns gestureNONE for anything else. */
+eGesture eGestureFeed( xGesture *pxGesture, const xDebounceEvent *pxEvent );
+
+/* How long the press last classified was held, in ticks. */
+TickType_t xGestureHeld( const xGesture *pxGesture );
+
+#endif
+
@@ -0,0 +1,59 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+/* Tickless idle for the LPC2129.  Set configUSE_TICKLESS_IDLE to 2 and map
+portSUPPRESS_TICKS_AND_SLEEP() to vLowPowerSleep() in FreeRTOSConfig.h, and
+the idle task stops the tick for as long as no task needs to run.  Anything
+that relies on every tick, a tick hook for one, sees nothing while the tick is
+stopped, so leave tickless idle off for applications that have one. */
+
+/* Called by the kernel, from the idle task with the scheduler suspended. 
+Reprograms Timer0 to raise the tick interrupt only after xExpectedIdleTime
+ticks, puts the processor in idle mode until that or any other interrupt, 
+then steps the tick count on by the whole ticks Timer0 counted.  When no task
+waits with a timeout and only external interrupts set in EXTWAKE are enabled
+in the VIC, it powers down instead, see xEintOpen(). */
+void vLowPowerSleep( TickType_t xExpectedIdleTime );
+
+/* How many times the processor has slept, how many of those were power 
+downs, and how many ticks it slept through in idle mode.  Over an interval,
+sleeps plus the ticks not slept through is the number of times the processor
+woke, against configTICK_RATE_HZ a second with the tick running. */
+typedef struct LOWPOWER_STATS
+{
+	unsigned long ulSleeps;
+	unsigned long ulPowerDowns;
+	unsigned long ulTicksAsleep;
+} xLowPowerStats;
+
+void vLowPowerGetStats( xLowPowerStats *pxStats );
+
+#endif
+
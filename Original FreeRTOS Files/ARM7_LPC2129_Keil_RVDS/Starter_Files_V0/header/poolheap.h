@@ -0,0 +1,80 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef POOL_HEAP_H
+#define POOL_HEAP_H
+
+/* pvPortMalloc() and vPortFree() on fixed size blocks, in place of heap_2.c.
+Only used when configSUPPORT_DYNAMIC_ALLOCATION is 1.  Each size class is a
+pool of equal blocks sized for one of the things the kernel allocates: task
+control blocks, configMINIMAL_STACK_SIZE stacks and queues with up to 
+poolheapQUEUE_STORAGE_BYTES of storage, semaphores included.  A request takes
+a block from the smallest class it fits that has one free, and a free puts 
+the block back on its class's list, so neither depends on how many blocks 
+there are or what was allocated before.  A request bigger than every class
+fails.  Set poolheapENABLE to 0 to link a kernel heap_x.c instead. */
+#ifndef poolheapENABLE
+	#define poolheapENABLE				1
+#endif
+
+/* Blocks in each class.  FreeRTOSConfig.h may set any of them. */
+#ifndef poolheapTCB_BLOCKS
+	#define poolheapTCB_BLOCKS			( 8 )
+#endif
+
+#ifndef poolheapSTACK_BLOCKS
+	#define poolheapSTACK_BLOCKS		( 8 )
+#endif
+
+#ifndef poolheapQUEUE_BLOCKS
+	#define poolheapQUEUE_BLOCKS		( 8 )
+#endif
+
+/* Storage a queue block has room for besides the queue itself. */
+#ifndef poolheapQUEUE_STORAGE_BYTES
+	#define poolheapQUEUE_STORAGE_BYTES	( 16 )
+#endif
+
+/* The occupancy of one class.  uxPeak is the most blocks ever in use at 
+once, and ulExhausted the number of requests that fitted the class but found
+it empty, and so went to a bigger class or failed. */
+typedef struct POOL_STATS
+{
+	const char *pcName;
+	size_t xBlockSize;
+	unsigned portBASE_TYPE uxBlocks;
+	unsigned portBASE_TYPE uxUsed;
+	unsigned portBASE_TYPE uxPeak;
+	unsigned long ulExhausted;
+} xPoolStats;
+
+/* The number of classes, and the occupancy of class uxClass. */
+unsigned portBASE_TYPE uxPoolClasses( void );
+void vPoolGetStats( unsigned portBASE_TYPE uxClass, xPoolStats *pxStats );
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PWM_H
+#define PWM_H
+
+/* Hands ePin over to the PWM block, which then drives it high for the first 
+xOnTicks of every xPeriod ticks with no help from the processor.  Calling it
+again for the same pin changes the rate or duty from the next period.  The 
+channels share one period, so a second pin can only run at the rate of the
+first.  Returns pdFAIL, and leaves the pin alone, if the pin has no PWM 
+output the GPIO layer can address (only P0.21, PIN5, does, see pwm.c), if 
+the rate clashes, or if xOnTicks leaves nothing to toggle.  Assumes the 
+peripheral clock is the processor clock. */
+signed portBASE_TYPE xPWMStart( portX_t ePort, pinX_t ePin, TickType_t xPeriod, TickType_t xOnTicks );
+
+/* Gives the pin back to GPIO, at whatever level the GPIO output latch has. */
+void vPWMStop( portX_t ePort, pinX_t ePin );
+
+#endif
+
@@ -0,0 +1,41 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef RUN_STATS_H
+#define RUN_STATS_H
+
+/* Reports how much of the processor each task used on pxReportPort every 
+xPeriod ticks.  Needs configGENERATE_RUN_TIME_STATS and 
+configUSE_TRACE_FACILITY, with the run-time counter taken from 
+ulTimebaseMicros(), see timebase.h, and INCLUDE_xTaskGetIdleTaskHandle.  
+Only one task at a time may write to a port, so if other tasks write to 
+pxReportPort pass a mutex that they all hold while they do, or NULL if the 
+port is the report's alone.  The whole report is written under it. */
+void vStartRunTimeStatsTask( xComPortHandle pxReportPort, SemaphoreHandle_t xPortMutex, unsigned portBASE_TYPE uxPriority, TickType_t xPeriod );
+
+#endif
+
@@ -86,10 +86,85 @@ typedef enum
 	ser115200
 } eBaud;
 
-void xSerialPortInitMinimal( unsigned long ulWantedBaud);
-signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength);
-signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar);
-void xSerialPutChar(signed char cOutChar);
+/* Number of received characters in the Rx FIFO that raise an Rx interrupt. */
+typedef enum
+{
+	serRX_TRIGGER_1,
+	serRX_TRIGGER_4,
+	serRX_TRIGGER_8,
+	serRX_TRIGGER_14
+} eRxTrigger;
+
+/* Per port counters, see vSerialGetStats().  All of them only ever count up, 
+except ulRxHighWater which is a peak. */
+typedef struct
+{
+	unsigned long ulTxBytes;
+	unsigned long ulRxBytes;
+	unsigned long ulRxDropped;		/* Characters lost because the Rx ring was full. */
+	unsigned long ulRxHighWater;	/* Most characters ever waiting in the Rx ring. */
+	unsigned long ulOverrunErrors;	/* Characters lost because the Rx FIFO was full. */
+	unsigned long ulParityErrors;
+	unsigned long ulFramingErrors;
+	unsigned long ulBreaks;
+	unsigned long ulInterrupts;		/* UART interrupts taken. */
+	unsigned long ulTxRefills;		/* THRE interrupts that refilled the Tx FIFO, ulTxBytes / ulTxRefills is the average burst. */
+} xSerialStats;
+
+/* Transmit descriptor for xSerialSubmit().  The ISR sends ulLength bytes 
+straight from pucData, then moves on to pxNext.  The descriptor and the data
+belong to the driver from submission until xComplete is set, at which point
+pvCallback (if not NULL) is also called from the ISR with the descriptor.  The
+callback must not submit further descriptors.  It passes the last parameter to
+any FromISR API it calls so the ISR can switch to a woken task on exit. */
+typedef struct SERIAL_TX_DESCRIPTOR
+{
+	const unsigned char *pucData;
+	unsigned long ulLength;
+	struct SERIAL_TX_DESCRIPTOR *pxNext;
+	void ( *pvCallback )( struct SERIAL_TX_DESCRIPTOR *pxDescriptor, portBASE_TYPE *pxHigherPriorityTaskWoken );
+	void *pvContext;
+	volatile portBASE_TYPE xComplete;
+} xSerialTxDescriptor;
+
+/* serCOM1 is UART0 and serCOM2 is UART1, the other ports do not exist.  Returns
+NULL if the port does not exist or the rate cannot be generated. */
+xComPortHandle xSerialPortInit( eCOMPort ePort, eBaud eWantedBaud, eParity eWantedParity, eDataBits eWantedDataBits, eStopBits eWantedStopBits );
+
+/* Opens UART1 with 8 data bits, no parity and 1 stop bit.  Returns NULL if the
+rate cannot be generated. */
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud);
+
+/* Queues usStringLength characters for transmission.  A string that fits the
+Tx ring, serTX_BUFFER_SIZE (64 by default) characters, is taken whole without 
+blocking, or refused with pdFALSE if there is not room for all of it.  A 
+longer string is refused unless the ring is empty, and is then fed into the 
+ring as the ISR drains it, blocking the calling task until it is all in, so 
+it can only be sent from a task.  Use xSerialWrite() to stream long or 
+frequent output with a time limit. */
+signed portBASE_TYPE vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength );
+signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar );
+
+/* Copies out everything waiting in the Rx ring, up to ulMaxLength characters,
+without blocking.  Returns the number copied. */
+unsigned long xSerialGetBytes( xComPortHandle pxPort, signed char *pcBuffer, unsigned long ulMaxLength );
+signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed char cOutChar );
+void vSerialSetRxTrigger( xComPortHandle pxPort, eRxTrigger eTriggerLevel );
+
+/* Changes the baud rate of an open port once everything already queued for 
+transmission has gone out, blocking the calling task until then.  The rings 
+are kept.  Characters received while the two ends disagree on the rate will be
+garbled, so switch at an agreed point in the protocol.  Returns pdFAIL if the 
+rate cannot be generated. */
+signed portBASE_TYPE xSerialSetBaud( xComPortHandle pxPort, eBaud eWantedBaud );
+signed portBASE_TYPE xSerialSubmit( xComPortHandle pxPort, xSerialTxDescriptor *pxDescriptor );
+void vSerialGetStats( xComPortHandle pxPort, xSerialStats *pxStats );
+
+/* Blocking transfers.  Both return the number of characters moved, which is
+less than ulLength only if xBlockTime expired first.  The calling task waits on
+its direct to task notification. */
+unsigned long xSerialRead( xComPortHandle pxPort, signed char *pcBuffer, unsigned long ulLength, TickType_t xBlockTime );
+unsigned long xSerialWrite( xComPortHandle pxPort, const signed char *pcBuffer, unsigned long ulLength, TickType_t xBlockTime );
 
 #endif
 
@@ -0,0 +1,74 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef SLIP_H
+#define SLIP_H
+
+/* Bytes added to every packet for the CRC. */
+#define slipCRC_LENGTH		2
+
+/* Incremental decoder state, see vSlipDecoderInit(). */
+typedef struct SLIP_DECODER
+{
+	unsigned char *pucBuffer;		/* Receives the payload followed by its CRC. */
+	unsigned short usBufferLength;
+	unsigned short usLength;		/* Bytes stored for the current packet so far. */
+	unsigned short usCRC;			/* CRC of those bytes. */
+	portBASE_TYPE xEscaped;			/* The last byte was an ESC. */
+	portBASE_TYPE xDiscarding;		/* The current packet overflowed and is being skipped. */
+	unsigned long ulPackets;		/* Good packets decoded. */
+	unsigned long ulCRCErrors;		/* Packets dropped because the CRC did not match. */
+	unsigned long ulOverflows;		/* Packets dropped because they did not fit in pucBuffer. */
+} xSlipDecoder;
+
+/* pucBuffer must be slipCRC_LENGTH bytes longer than the largest payload 
+expected. */
+void vSlipDecoderInit( xSlipDecoder *pxDecoder, unsigned char *pucBuffer, unsigned short usBufferLength );
+
+/* Feeds one received byte to the decoder.  Returns the payload length when
+the byte completes a good packet, which is then at the start of pucBuffer, or
+0 otherwise. */
+unsigned short usSlipDecodeByte( xSlipDecoder *pxDecoder, unsigned char ucByte );
+
+/* Decodes straight from the port's Rx ring until a good packet arrives or 
+xBlockTime expires.  Returns the payload length, or 0 on timeout.  A packet 
+that is still partly received on timeout carries on with the next call. */
+unsigned short usSlipReceive( xComPortHandle pxPort, xSlipDecoder *pxDecoder, TickType_t xBlockTime );
+
+/* Encodes a packet and its CRC as it is written to the port, without 
+building the whole frame first.  Returns pdFAIL if the frame could not be 
+written completely within xBlockTime, in which case the receiver discards the
+partial frame when the next one starts. */
+signed portBASE_TYPE xSlipSend( xComPortHandle pxPort, const unsigned char *pucData, unsigned short usLength, TickType_t xBlockTime );
+
+/* CRC-16/CCITT (polynomial 0x1021, initial value 0xffff) of a buffer, 
+continuing from usCRC. */
+unsigned short usSlipCRC( unsigned short usCRC, const unsigned char *pucData, unsigned long ulLength );
+
+#endif
+
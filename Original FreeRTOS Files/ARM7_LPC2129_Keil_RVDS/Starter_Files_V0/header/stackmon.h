@@ -0,0 +1,56 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+/* What unused stack holds.  The kernel fills task stacks with it when they
+are created and Startup.s the mode stacks at reset. */
+#define stackmonPAINT				( ( unsigned long ) 0xA5A5A5A5 )
+
+/* How much a recommended size leaves over the deepest use seen so far, as a
+fraction of that use, and the least it leaves. */
+#define stackmonMARGIN_DIVISOR		( 4 )
+#define stackmonMIN_MARGIN_BYTES	( 32 )
+
+/* Reports every task's and every ARM mode's stack on pxReportPort every
+xPeriod ticks: its size, the least of it that has ever been free and the
+smallest size that would have left a safe margin over the deepest use, see
+stackmon.c for the format.  Only what has run so far is measured, so run the
+application through everything it does before trusting a recommendation.  
+xPortMutex is held while the report is written, as for 
+vStartRunTimeStatsTask(), or NULL if nothing else writes to pxReportPort. */
+void vStartStackMonitorTask( xComPortHandle pxReportPort, SemaphoreHandle_t xPortMutex, unsigned portBASE_TYPE uxPriority, TickType_t xPeriod );
+
+/* The kernel does not say how big a task's stack is, so FreeRTOSConfig.h
+tells the monitor from traceTASK_CREATE() and traceTASK_DELETE(), which needs
+configRECORD_STACK_HIGH_ADDRESS.  pvTask is the task's handle. */
+void vStackMonitorTaskCreated( void *pvTask, unsigned long ulStackWords );
+void vStackMonitorTaskDeleted( void *pvTask );
+
+#endif
+
@@ -0,0 +1,45 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef STRFMT_H
+#define STRFMT_H
+
+/* Enough for every digit of an unsigned long, which has fewer than three 
+decimal digits per byte.  Also right on the host, where it is 64 bits.  
+Callers size their buffers with it, one per number appended. */
+#define strfmtMAX_DIGITS			( sizeof( unsigned long ) * 3 )
+
+/* Append a string, or the decimal representation of ulValue, to pcBuffer and 
+return a pointer to the new end of the string, so calls can be chained to 
+build a report line without pulling in sprintf().  The result is always NUL
+terminated and the caller sizes pcBuffer. */
+char *pcStrFmtAppendString( char *pcBuffer, const char *pcString );
+char *pcStrFmtAppendNumber( char *pcBuffer, unsigned long ulValue );
+
+#endif
+
@@ -0,0 +1,63 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+/* Timer1 runs free at the peripheral clock, which main() sets to the 
+processor clock, and its count wraps every 2^32 counts.  Take differences of 
+ulTimebaseNow() values as unsigned long to time anything shorter than that. */
+#define timebaseHZ					( configCPU_CLOCK_HZ )
+
+/* The host build counts with the host's clock instead, by defining 
+timebaseNOW() in its lpc21xx.h.  Include this header after lpc21xx.h. */
+#ifdef timebaseNOW
+	#define timebaseFROM_TIMER1		0
+#else
+	#define timebaseFROM_TIMER1		1
+#endif
+
+/* Starts Timer1.  Call once VPBDIV has been set. */
+void vTimebaseInit( void );
+unsigned long ulTimebaseNow( void );
+
+/* Timer1 counted on in microseconds, wrapping at 2^32 after a little over 71
+minutes, for configGENERATE_RUN_TIME_STATS.  It only catches up with Timer1 
+when called, so it must be called at least once every 2^32 Timer1 counts, 
+which the context switch does.  Can be called with IRQs masked or not. */
+#define timebaseCOUNTS_PER_US		( timebaseHZ / 1000000UL )
+
+unsigned long ulTimebaseMicros( void );
+
+/* Raises the Timer1 interrupt, VIC channel 5, ulDelay counts from now and 
+returns the count at which it will.  Its handler calls vTimebaseClearAlarm().
+Timer1's count goes on uninterrupted. */
+unsigned long ulTimebaseSetAlarm( unsigned long ulDelay );
+void vTimebaseClearAlarm( void );
+
+#endif
+
@@ -9,102 +9,90 @@
 
 void GPIO_init(void)
 {
-	int i;
-	
-	for(i = 0; i < PinConfig_array_size;i++)
-	{
-		switch(PinConfig_array[i].Port)
-		{
-			case PORT_0:
-				if(INPUT == PinConfig_array[i].Direction)
-				{
-					CLR_BIT(IODIR0, PinConfig_array[i].Pin);
-				}
-				else if (OUTPUT == PinConfig_array[i].Direction)
-				{
-					SET_BIT(IODIR0, PinConfig_array[i].Pin);
-				}
-				else
-				{
-					
-				}
-				break;
-	
-			case PORT_1:
-				if(INPUT == PinConfig_array[i].Direction)
-				{
-					CLR_BIT(IODIR1, PinConfig_array[i].Pin);
-				}
-				else if (OUTPUT == PinConfig_array[i].Direction)
-				{
-					SET_BIT(IODIR1, PinConfig_array[i].Pin);
-				}
-				else
-				{
-
-				}
-				break;
-	
-			default:
-		}
-	}
+	/* GPIO_Config covers P0.16 to P0.31 and P1.16 to P1.31 whole, so PINSEL1
+	   is stored outright.  The lower half of each IODIR belongs to the pins
+	   the table does not describe and is kept. */
+	PINSEL1 = GPIO_Config.PinSel1;
+	IODIR0 = (IODIR0 & ~GPIO_CFG_PORT_MASK) | GPIO_Config.Dir0;
+	IODIR1 = (IODIR1 & ~GPIO_CFG_PORT_MASK) | GPIO_Config.Dir1;
 }
 
 
 pinState_t GPIO_read(portX_t PortName, pinX_t pinNum)
 {
-	pinState_t state;
-	
-	switch(PortName)
-	{
-		case PORT_0:
-			{
-				state = (pinState_t) GET_BIT(IOPIN0, pinNum);
-				break;
-			}
+	return (pinState_t) GET_BIT(GPIO_readPort(PortName), pinNum);
+}
 
-		case PORT_1:
-			{
-				state = (pinState_t) GET_BIT(IOPIN1, pinNum);
-				break;
-			}
+
+void GPIO_write(portX_t portName, pinX_t pinNum, pinState_t pinState)
+{
+	/* IOSET and IOCLR are write only, storing the one bit leaves the other
+	   pins alone where SET_BIT() would write back whatever the read returned. */
+	if(PIN_IS_LOW == pinState)
+	{
+		GPIO_writeMask(portName, 0, GPIO_PIN_MASK(pinNum));
+	}
+	else if (PIN_IS_HIGH == pinState)
+	{
+		GPIO_writeMask(portName, GPIO_PIN_MASK(pinNum), 0);
+	}
+	else
+	{
+		
 	}
-	
-	return state;
 }
 
 
-void GPIO_write(portX_t portName, pinX_t pinNum, pinState_t pinState)
+void GPIO_writeMask(portX_t portName, uint32_t setMask, uint32_t clrMask)
 {
 	switch(portName)
 	{
 		case PORT_0:
-			if(PIN_IS_LOW == pinState)
+			if(0 != setMask)
 			{
-				SET_BIT(IOCLR0, pinNum);
+				IOSET0 = setMask;
 			}
-			else if (PIN_IS_HIGH == pinState)
+			if(0 != clrMask)
 			{
-				SET_BIT(IOSET0, pinNum);
-			}
-			else
-			{
-				
+				IOCLR0 = clrMask;
 			}
 			break;
 
 		case PORT_1:
-			if(PIN_IS_LOW == pinState)
-			{
-				SET_BIT(IOCLR1, pinNum);
-			}
-			else if (PIN_IS_HIGH == pinState)
+			if(0 != setMask)
 			{
-				SET_BIT(IOSET1, pinNum);
+				IOSET1 = setMask;
 			}
-			else
+			if(0 != clrMask)
 			{
-				
+				IOCLR1 = clrMask;
 			}
+			break;
+
+		default:
+			break;
 	}
 }
+
+
+uint32_t GPIO_readPort(portX_t portName)
+{
+	uint32_t value;
+	
+	switch(portName)
+	{
+		case PORT_0:
+			value = IOPIN0;
+			break;
+
+		case PORT_1:
+			value = IOPIN1;
+			break;
+
+		default:
+			value = 0;
+			break;
+	}
+	
+	return value;
+}
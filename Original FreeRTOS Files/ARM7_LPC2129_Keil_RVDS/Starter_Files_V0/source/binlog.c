@@ -0,0 +1,291 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Deferred format binary logger.
+ *
+ * A call to one of the binLOGn() macros costs a short critical section to 
+ * claim a slot, plus a few stores to fill it.  No text is formatted on the 
+ * target: each record holds the message ID from binlog_ids.h, the tick count
+ * and up to binlogMAX_ARGS raw 32 bit arguments.
+ *
+ * The slots form a ring with any number of producers and the drain task as 
+ * the only consumer.  The ARM7TDMI has no exclusive load/store, so a slot is 
+ * claimed by advancing uxHead inside a critical section only long enough for
+ * the compare and increment.  The slot is filled outside the critical section
+ * and published by setting ucReady last, with a compiler barrier between the
+ * two.  volatile only orders ucReady against other volatile accesses, and 
+ * the compiler would otherwise be free to sink the record's plain stores 
+ * below it, or hoist the drain task's reads of them above its test of it.  
+ * The ARM7TDMI is a single in-order core, so nothing more than a compiler
+ * barrier is needed.  The drain task only moves past a
+ * slot once it is ready, so records always leave in the order their slots 
+ * were claimed.  ISRs on this port cannot nest, so vBinLogFromISR() needs no
+ * critical section at all.
+ *
+ * Each record goes out over the serial port as:
+ *
+ *     0xa5 | ID | argument count | tick (4) | arguments (4 each) | checksum
+ *
+ * with multi-byte fields little endian and the checksum chosen so the bytes 
+ * after the 0xa5 sum to zero modulo 256.  tools/binlog_decode.py turns the 
+ * stream back into text.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "serial.h"
+#include "binlog.h"
+
+/* Must be a power of two.  Each slot is 24 bytes. */
+#ifndef binlogBUFFER_LENGTH
+	#define binlogBUFFER_LENGTH		16
+#endif
+
+#define binlogSTACK_SIZE			configMINIMAL_STACK_SIZE
+#define binlogDRAIN_PERIOD			( ( TickType_t ) 10 / portTICK_PERIOD_MS )
+#define binlogSYNC					( ( unsigned char ) 0xa5 )
+#define binlogMAX_FRAME_LENGTH		( 8 + ( binlogMAX_ARGS * 4 ) )
+
+/* Stops the compiler moving memory accesses across it.  The host build 
+supplies its own, see serial.c. */
+#ifndef binlogBARRIER
+	#define binlogBARRIER()			__memory_changed()
+#endif
+
+#if ( binlogBUFFER_LENGTH & ( binlogBUFFER_LENGTH - 1 ) ) != 0
+	#error binlogBUFFER_LENGTH must be a power of two.
+#endif
+
+/* The ID is sent as a single byte. */
+typedef char binlogMESSAGES_has_too_many_rows[ ( binlogNUM_MESSAGES <= 256 ) ? 1 : -1 ];
+
+/*-----------------------------------------------------------*/
+
+typedef struct BINLOG_RECORD
+{
+	unsigned char ucID;
+	unsigned char ucArgs;
+	volatile unsigned char ucReady;		/* Set by the producer once the rest of the slot is written. */
+	unsigned long ulTime;
+	unsigned long ulArgs[ binlogMAX_ARGS ];
+} xBinLogRecord;
+
+/*-----------------------------------------------------------*/
+
+static void vBinLogTask( void *pvParameters );
+
+/*
+ * Fill in and publish a slot claimed by one of the logging functions.
+ */
+static void prvFillRecord( xBinLogRecord *pxRecord, eBinLogID eID, unsigned portBASE_TYPE uxArgs, TickType_t xTime, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+
+/*
+ * Frame a record into pucFrame and return the frame length.
+ */
+static unsigned portBASE_TYPE prvBuildFrame( unsigned char *pucFrame, unsigned char ucID, unsigned char ucArgs, unsigned long ulTime, const unsigned long *pulArgs );
+
+/*-----------------------------------------------------------*/
+
+static xBinLogRecord xRecords[ binlogBUFFER_LENGTH ];
+
+/* uxHead is advanced by the producers, uxTail by the drain task.  Both are 
+free running. */
+static volatile unsigned portBASE_TYPE uxHead = 0;
+static volatile unsigned portBASE_TYPE uxTail = 0;
+
+/* Records lost because the ring was full, reported by the drain task. */
+static volatile unsigned long ulDropped = 0;
+
+static xComPortHandle xLogPort = NULL;
+
+/* The drain task's stack and TCB. */
+static StackType_t xBinLogStack[ binlogSTACK_SIZE ];
+static StaticTask_t xBinLogTCB;
+
+/*-----------------------------------------------------------*/
+
+void vBinLog( eBinLogID eID, unsigned portBASE_TYPE uxArgs, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+xBinLogRecord *pxRecord = NULL;
+TickType_t xTime;
+
+	portENTER_CRITICAL();
+	{
+		if( ( uxHead - uxTail ) < binlogBUFFER_LENGTH )
+		{
+			pxRecord = &( xRecords[ uxHead & ( binlogBUFFER_LENGTH - 1 ) ] );
+			uxHead++;
+		}
+		else
+		{
+			ulDropped++;
+		}
+	}
+	portEXIT_CRITICAL();
+
+	if( pxRecord != NULL )
+	{
+		xTime = xTaskGetTickCount();
+		prvFillRecord( pxRecord, eID, uxArgs, xTime, ulArg1, ulArg2, ulArg3, ulArg4 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBinLogFromISR( eBinLogID eID, unsigned portBASE_TYPE uxArgs, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+xBinLogRecord *pxRecord;
+
+	/* Interrupts are already disabled. */
+	if( ( uxHead - uxTail ) < binlogBUFFER_LENGTH )
+	{
+		pxRecord = &( xRecords[ uxHead & ( binlogBUFFER_LENGTH - 1 ) ] );
+		uxHead++;
+		prvFillRecord( pxRecord, eID, uxArgs, xTaskGetTickCountFromISR(), ulArg1, ulArg2, ulArg3, ulArg4 );
+	}
+	else
+	{
+		ulDropped++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillRecord( xBinLogRecord *pxRecord, eBinLogID eID, unsigned portBASE_TYPE uxArgs, TickType_t xTime, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+	pxRecord->ucID = ( unsigned char ) eID;
+	pxRecord->ucArgs = ( unsigned char ) ( ( uxArgs > binlogMAX_ARGS ) ? binlogMAX_ARGS : uxArgs );
+	pxRecord->ulTime = ( unsigned long ) xTime;
+	pxRecord->ulArgs[ 0 ] = ulArg1;
+	pxRecord->ulArgs[ 1 ] = ulArg2;
+	pxRecord->ulArgs[ 2 ] = ulArg3;
+	pxRecord->ulArgs[ 3 ] = ulArg4;
+
+	/* Publish the record, only once every store above has been made. */
+	binlogBARRIER();
+	pxRecord->ucReady = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vStartBinLogTask( xComPortHandle pxPort, unsigned portBASE_TYPE uxPriority )
+{
+	xLogPort = pxPort;
+	xTaskCreateStatic( vBinLogTask, "BinLog", binlogSTACK_SIZE, NULL, uxPriority, xBinLogStack, &xBinLogTCB );
+}
+/*-----------------------------------------------------------*/
+
+static void vBinLogTask( void *pvParameters )
+{
+xBinLogRecord *pxRecord;
+unsigned char ucFrame[ binlogMAX_FRAME_LENGTH ];
+unsigned portBASE_TYPE uxLength;
+unsigned long ulLost;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( binlogDRAIN_PERIOD );
+
+		/* Report any records lost since the last time round. */
+		portENTER_CRITICAL();
+		{
+			ulLost = ulDropped;
+			ulDropped = 0UL;
+		}
+		portEXIT_CRITICAL();
+
+		if( ulLost != 0UL )
+		{
+			uxLength = prvBuildFrame( ucFrame, ( unsigned char ) binlogDROPPED, 1, ( unsigned long ) xTaskGetTickCount(), &ulLost );
+			xSerialWrite( xLogPort, ( signed char * ) ucFrame, uxLength, portMAX_DELAY );
+		}
+
+		/* Send every record that is ready, stopping at the first slot that 
+		has been claimed but not yet filled. */
+		while( uxTail != uxHead )
+		{
+			pxRecord = &( xRecords[ uxTail & ( binlogBUFFER_LENGTH - 1 ) ] );
+
+			if( pxRecord->ucReady == pdFALSE )
+			{
+				break;
+			}
+
+			/* Read the record only after seeing it published... */
+			binlogBARRIER();
+			uxLength = prvBuildFrame( ucFrame, pxRecord->ucID, pxRecord->ucArgs, pxRecord->ulTime, pxRecord->ulArgs );
+
+			/* ...and release the slot, which can be reused as soon as it has
+			been copied, only after every read of it has been made. */
+			binlogBARRIER();
+			pxRecord->ucReady = pdFALSE;
+			uxTail++;
+
+			xSerialWrite( xLogPort, ( signed char * ) ucFrame, uxLength, portMAX_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvBuildFrame( unsigned char *pucFrame, unsigned char ucID, unsigned char ucArgs, unsigned long ulTime, const unsigned long *pulArgs )
+{
+unsigned portBASE_TYPE uxLength = 0, uxArg, uxByte, uxIndex;
+unsigned long ulValue;
+unsigned char ucSum = 0;
+
+	pucFrame[ uxLength++ ] = binlogSYNC;
+	pucFrame[ uxLength++ ] = ucID;
+	pucFrame[ uxLength++ ] = ucArgs;
+
+	/* The tick count, then each argument, least significant byte first. */
+	for( uxArg = 0; uxArg <= ucArgs; uxArg++ )
+	{
+		ulValue = ( uxArg == 0 ) ? ulTime : pulArgs[ uxArg - 1 ];
+
+		for( uxByte = 0; uxByte < 4; uxByte++ )
+		{
+			pucFrame[ uxLength++ ] = ( unsigned char ) ( ulValue & 0xffUL );
+			ulValue >>= 8;
+		}
+	}
+
+	for( uxIndex = 1; uxIndex < uxLength; uxIndex++ )
+	{
+		ucSum += pucFrame[ uxIndex ];
+	}
+
+	pucFrame[ uxLength++ ] = ( unsigned char ) ( 0U - ucSum );
+
+	return uxLength;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,206 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Table driven LED blinker.
+ *
+ * An LED whose pin has a PWM output is handed to the PWM block and blinks 
+ * with no processor time at all.  For the rest, a single task works out, from
+ * the tick count it wakes at, the level each should have, writes each port 
+ * with one GPIO_writeMask() and sleeps until the nearest change of any of 
+ * them, or until vBlinkSet() notifies it.  Levels are worked out from the 
+ * tick count each time rather than toggled, so a late wake up does not push
+ * the LEDs out of step with each other.  With every LED in hardware or held
+ * at a steady level the task does not wake at all.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "GPIO.h"
+#include "pwm.h"
+#include "blink.h"
+
+#define blinkSTACK_SIZE				configMINIMAL_STACK_SIZE
+#define blinkNUM_PORTS				( 2 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct BLINK_STATE
+{
+	xBlinkEntry xEntry;
+	portBASE_TYPE xInHardware;
+} xBlinkState;
+
+static void vBlinkTask( void *pvParameters );
+static void prvPlaceEntry( xBlinkState *pxState );
+
+/* Only one blink task runs, so its state need not be allocated. */
+static xBlinkState xStates[ blinkMAX_ENTRIES ];
+static unsigned portBASE_TYPE uxNumEntries = 0;
+static TaskHandle_t xBlinkTaskHandle = NULL;
+static StackType_t xBlinkStack[ blinkSTACK_SIZE ];
+static StaticTask_t xBlinkTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartBlinkTask( const xBlinkEntry *pxTable, unsigned portBASE_TYPE uxEntries, unsigned portBASE_TYPE uxPriority )
+{
+unsigned portBASE_TYPE ux;
+
+	configASSERT( uxEntries <= blinkMAX_ENTRIES );
+
+	for( ux = 0; ux < uxEntries; ux++ )
+	{
+		configASSERT( pxTable[ ux ].xPeriod != 0 );
+		xStates[ ux ].xEntry = pxTable[ ux ];
+		xStates[ ux ].xInHardware = pdFALSE;
+		prvPlaceEntry( &xStates[ ux ] );
+	}
+
+	uxNumEntries = uxEntries;
+
+	xBlinkTaskHandle = xTaskCreateStatic( vBlinkTask, "Blink", blinkSTACK_SIZE, NULL, uxPriority, xBlinkStack, &xBlinkTCB );
+}
+/*-----------------------------------------------------------*/
+
+void vBlinkSet( unsigned portBASE_TYPE uxEntry, TickType_t xPeriod, TickType_t xOnTicks )
+{
+	configASSERT( uxEntry < uxNumEntries );
+	configASSERT( xPeriod != 0 );
+
+	/* Keeps the task from working with half an update. */
+	vTaskSuspendAll();
+	{
+		xStates[ uxEntry ].xEntry.xPeriod = xPeriod;
+		xStates[ uxEntry ].xEntry.xOnTicks = xOnTicks;
+		prvPlaceEntry( &xStates[ uxEntry ] );
+	}
+	( void ) xTaskResumeAll();
+
+	/* The task may be asleep until a change the entry no longer has. */
+	xTaskNotifyGive( xBlinkTaskHandle );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xBlinkInHardware( unsigned portBASE_TYPE uxEntry )
+{
+	configASSERT( uxEntry < uxNumEntries );
+
+	return xStates[ uxEntry ].xInHardware;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceEntry( xBlinkState *pxState )
+{
+const xBlinkEntry *pxEntry = &( pxState->xEntry );
+
+	if( xPWMStart( pxEntry->ePort, pxEntry->ePin, pxEntry->xPeriod, pxEntry->xOnTicks ) == pdPASS )
+	{
+		pxState->xInHardware = pdTRUE;
+	}
+	else if( pxState->xInHardware != pdFALSE )
+	{
+		/* The pin goes back to GPIO at the latch's level until the task 
+		next writes it. */
+		vPWMStop( pxEntry->ePort, pxEntry->ePin );
+		pxState->xInHardware = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vBlinkTask( void *pvParameters )
+{
+const xBlinkEntry *pxEntry;
+unsigned long ulSet[ blinkNUM_PORTS ], ulClear[ blinkNUM_PORTS ];
+TickType_t xNow, xIntoPeriod, xUntilChange, xWait;
+unsigned portBASE_TYPE ux;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulSet[ PORT_0 ] = ulSet[ PORT_1 ] = 0UL;
+		ulClear[ PORT_0 ] = ulClear[ PORT_1 ] = 0UL;
+		xWait = portMAX_DELAY;
+
+		vTaskSuspendAll();
+		{
+			xNow = xTaskGetTickCount();
+
+			for( ux = 0; ux < uxNumEntries; ux++ )
+			{
+				if( xStates[ ux ].xInHardware != pdFALSE )
+				{
+					continue;
+				}
+
+				pxEntry = &( xStates[ ux ].xEntry );
+
+				/* Added rather than subtracted, as a phase later than the 
+				tick count would otherwise wrap to the wrong place in the 
+				period. */
+				xIntoPeriod = ( xNow + ( pxEntry->xPeriod - ( pxEntry->xPhase % pxEntry->xPeriod ) ) ) % pxEntry->xPeriod;
+
+				if( pxEntry->xOnTicks >= pxEntry->xPeriod )
+				{
+					/* Always on, nothing to wake for. */
+					ulSet[ pxEntry->ePort ] |= GPIO_PIN_MASK( pxEntry->ePin );
+					xUntilChange = portMAX_DELAY;
+				}
+				else if( xIntoPeriod < pxEntry->xOnTicks )
+				{
+					ulSet[ pxEntry->ePort ] |= GPIO_PIN_MASK( pxEntry->ePin );
+					xUntilChange = pxEntry->xOnTicks - xIntoPeriod;
+				}
+				else
+				{
+					/* Also catches an LED that is always off, which stays
+					here for the rest of the period. */
+					ulClear[ pxEntry->ePort ] |= GPIO_PIN_MASK( pxEntry->ePin );
+					xUntilChange = ( pxEntry->xOnTicks == 0 ) ? portMAX_DELAY : ( pxEntry->xPeriod - xIntoPeriod );
+				}
+
+				if( xUntilChange < xWait )
+				{
+					xWait = xUntilChange;
+				}
+			}
+
+			GPIO_writeMask( PORT_0, ulSet[ PORT_0 ], ulClear[ PORT_0 ] );
+			GPIO_writeMask( PORT_1, ulSet[ PORT_1 ], ulClear[ PORT_1 ] );
+		}
+		( void ) xTaskResumeAll();
+
+		/* Levels come from the tick count, so waking late, or early on a
+		notification, does not drift. */
+		( void ) ulTaskNotifyTake( pdTRUE, xWait );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,199 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Debounces every pin of both ports at once from the tick hook.
+ *
+ * Each port is read with one load and fed to a two bit vertical counter per
+ * pin: bit n of ulCount0 and ulCount1 together count how many samples in a
+ * row pin n has differed from its debounced level.  Any sample that agrees 
+ * clears the count, and the fourth that disagrees flips the debounced level.
+ * The update is the same handful of logic operations whether one pin is in
+ * use or all 32, and a sample with nothing changing ends at the first test.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo application includes. */
+#include "GPIO.h"
+#include "debounce.h"
+
+#define debounceNUM_PORTS			( 2 )
+#define debounceMAX_SUBSCRIBERS		( 4 )
+
+#if ( debounceSAMPLES != 4 )
+	#error The two bit vertical counters count debounceSAMPLES == 4 samples.
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct DEBOUNCE_PORT
+{
+	unsigned long ulState;		/* Debounced levels. */
+	unsigned long ulCount0;		/* Low bits of the counters. */
+	unsigned long ulCount1;		/* High bits of the counters. */
+} xDebouncePort;
+
+typedef struct DEBOUNCE_SUBSCRIBER
+{
+	portX_t ePort;
+	unsigned long ulMask;
+	unsigned long ulActiveLow;
+	QueueHandle_t xQueue;
+} xDebounceSubscriber;
+
+static xDebouncePort xPorts[ debounceNUM_PORTS ];
+static xDebounceSubscriber xSubscribers[ debounceMAX_SUBSCRIBERS ];
+static volatile unsigned portBASE_TYPE uxSubscribers = 0;
+static volatile unsigned long ulDropped = 0;
+static TickType_t xTicksToSample = 0;
+static portBASE_TYPE xSampled = pdFALSE;
+
+static void prvPublish( portX_t ePort, unsigned long ulChanged, unsigned long ulState );
+
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xDebounceSubscribe( portX_t ePort, unsigned long ulMask, unsigned long ulActiveLow, QueueHandle_t xQueue )
+{
+signed portBASE_TYPE xReturn = pdFAIL;
+xDebounceSubscriber *pxSubscriber;
+
+	portENTER_CRITICAL();
+	{
+		if( uxSubscribers < debounceMAX_SUBSCRIBERS )
+		{
+			pxSubscriber = &xSubscribers[ uxSubscribers ];
+			pxSubscriber->ePort = ePort;
+			pxSubscriber->ulMask = ulMask;
+			pxSubscriber->ulActiveLow = ulActiveLow;
+			pxSubscriber->xQueue = xQueue;
+
+			/* The tick hook only reads entries below the count. */
+			uxSubscribers++;
+			xReturn = pdPASS;
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulDebounceState( portX_t ePort )
+{
+	return xPorts[ ePort ].ulState;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulDebounceDropped( void )
+{
+	return ulDropped;
+}
+/*-----------------------------------------------------------*/
+
+void vDebounceTick( void )
+{
+unsigned portBASE_TYPE uxPort;
+unsigned long ulSample, ulDelta, ulChanged;
+xDebouncePort *pxPort;
+
+	if( xTicksToSample != 0 )
+	{
+		xTicksToSample--;
+		return;
+	}
+
+	xTicksToSample = debounceSAMPLE_TICKS - 1;
+
+	for( uxPort = 0; uxPort < debounceNUM_PORTS; uxPort++ )
+	{
+		pxPort = &xPorts[ uxPort ];
+		ulSample = GPIO_readPort( ( portX_t ) uxPort );
+
+		if( xSampled == pdFALSE )
+		{
+			/* The levels at start up are taken as they are, not as edges. */
+			pxPort->ulState = ulSample;
+			continue;
+		}
+
+		ulDelta = ulSample ^ pxPort->ulState;
+
+		/* Count on where the pin differs, clear where it agrees. */
+		pxPort->ulCount1 = ( pxPort->ulCount1 ^ pxPort->ulCount0 ) & ulDelta;
+		pxPort->ulCount0 = ~pxPort->ulCount0 & ulDelta;
+
+		/* The counters wrap to zero on the fourth sample in a row. */
+		ulChanged = ulDelta & ~( pxPort->ulCount0 | pxPort->ulCount1 );
+
+		if( ulChanged != 0UL )
+		{
+			pxPort->ulState ^= ulChanged;
+			prvPublish( ( portX_t ) uxPort, ulChanged, pxPort->ulState );
+		}
+	}
+
+	xSampled = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPublish( portX_t ePort, unsigned long ulChanged, unsigned long ulState )
+{
+unsigned portBASE_TYPE uxIndex;
+xDebounceSubscriber *pxSubscriber;
+xDebounceEvent xEvent;
+unsigned long ulActive;
+
+	xEvent.xTime = xTaskGetTickCountFromISR();
+	xEvent.ePort = ePort;
+	xEvent.ulState = ulState;
+
+	for( uxIndex = 0; uxIndex < uxSubscribers; uxIndex++ )
+	{
+		pxSubscriber = &xSubscribers[ uxIndex ];
+
+		if( ( pxSubscriber->ePort != ePort ) || ( ( pxSubscriber->ulMask & ulChanged ) == 0UL ) )
+		{
+			continue;
+		}
+
+		ulActive = ulState ^ pxSubscriber->ulActiveLow;
+		xEvent.ulPressed = ulChanged & pxSubscriber->ulMask & ulActive;
+		xEvent.ulReleased = ulChanged & pxSubscriber->ulMask & ~ulActive;
+
+		/* From the tick hook the kernel switches to a woken task itself as
+		the tick returns. */
+		if( xQueueSendFromISR( pxSubscriber->xQueue, &xEvent, NULL ) != pdPASS )
+		{
+			ulDropped++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
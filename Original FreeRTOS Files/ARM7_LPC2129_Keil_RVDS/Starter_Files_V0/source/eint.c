@@ -0,0 +1,240 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * External interrupt service.  Turns edges or levels on the EINT0 to EINT3
+ * pins into task notifications and queued, timestamped events, so a task
+ * that waits for an input blocks instead of polling the pin.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "eint.h"
+
+#define eintNUM_LINES				( 4 )
+
+/* System control block registers, offsets from eintSCB_BASE. */
+#define eintSCB_BASE				( ( unsigned long ) 0xE01FC000 )
+#define eintEXTINT					( ( unsigned long ) 0x140 )
+#define eintEXTWAKE					( ( unsigned long ) 0x144 )
+#define eintEXTMODE					( ( unsigned long ) 0x148 )
+#define eintEXTPOLAR				( ( unsigned long ) 0x14C )
+
+/* EINT0 to EINT3 are VIC channels 14 to 17, and take slots 4 to 7. */
+#define eintVIC_FIRST_CHANNEL		( ( unsigned long ) 14 )
+#define eintVIC_FIRST_SLOT			( 4 )
+#define eintVIC_ENABLE				( ( unsigned long ) 0x0020 )
+#define eintCLEAR_VIC_INTERRUPT		( ( unsigned long ) 0 )
+
+/* Register access.  The host build supplies its own, see serial.c. */
+#ifndef eintREAD
+	#define eintREAD( ulOffset )			( *( ( volatile unsigned long * ) ( eintSCB_BASE + ( ulOffset ) ) ) )
+	#define eintWRITE( ulOffset, ulValue )	( eintREAD( ulOffset ) = ( ulValue ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct EINT_LINE
+{
+	TaskHandle_t xTask;
+	QueueHandle_t xQueue;
+	portBASE_TYPE xLevel;				/* pdTRUE for a level triggered line. */
+	volatile unsigned long ulDropped;	/* Events xQueue had no room for. */
+} xEintLine;
+
+/*
+ * The asm wrapper, in eintISR.s, that saves the task context and calls
+ * vEint_ISRHandler().
+ */
+extern void vEint_ISREntry( void );
+
+/* Bit n set for each open line, read by the ISR. */
+static volatile unsigned long ulOpenLines = 0;
+static xEintLine xLines[ eintNUM_LINES ];
+
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xEintOpen( eEintLine eLine, eEintTrigger eTrigger, TaskHandle_t xTask, QueueHandle_t xQueue )
+{
+unsigned long ulBit = 1UL << ( unsigned long ) eLine;
+unsigned long ulChannel = eintVIC_FIRST_CHANNEL + ( unsigned long ) eLine;
+unsigned long ulMode, ulPolar, ulVPBDIV;
+signed portBASE_TYPE xReturn = pdFAIL;
+
+	portENTER_CRITICAL();
+	{
+		if( ( ulOpenLines & ulBit ) == 0UL )
+		{
+			xLines[ eLine ].xTask = xTask;
+			xLines[ eLine ].xQueue = xQueue;
+			xLines[ eLine ].xLevel = ( ( eTrigger == eintLOW_LEVEL ) || ( eTrigger == eintHIGH_LEVEL ) ) ? pdTRUE : pdFALSE;
+			xLines[ eLine ].ulDropped = 0UL;
+
+			ulMode = eintREAD( eintEXTMODE ) & ~ulBit;
+			ulPolar = eintREAD( eintEXTPOLAR ) & ~ulBit;
+
+			if( xLines[ eLine ].xLevel == pdFALSE )
+			{
+				ulMode |= ulBit;
+			}
+
+			if( ( eTrigger == eintRISING_EDGE ) || ( eTrigger == eintHIGH_LEVEL ) )
+			{
+				ulPolar |= ulBit;
+			}
+
+			/* The LPC2129 errata sheet has EXTMODE and EXTPOLAR only take a
+			write with VPBDIV at zero, so the divider is dropped around the
+			writes and put back. */
+			ulVPBDIV = VPBDIV;
+			VPBDIV = 0UL;
+			eintWRITE( eintEXTMODE, ulMode );
+			eintWRITE( eintEXTPOLAR, ulPolar );
+			VPBDIV = ulVPBDIV;
+
+			/* Changing the mode can set the flag, start from a clean one. */
+			eintWRITE( eintEXTINT, ulBit );
+			ulOpenLines |= ulBit;
+
+			/* An open line may wake the processor from power down, see
+			lowpower.c. */
+			eintWRITE( eintEXTWAKE, eintREAD( eintEXTWAKE ) | ulBit );
+
+			VICIntSelect &= ~( 1UL << ulChannel );
+			( &VICVectAddr0 )[ eintVIC_FIRST_SLOT + eLine ] = ( unsigned long ) vEint_ISREntry;
+			( &VICVectCntl0 )[ eintVIC_FIRST_SLOT + eLine ] = ulChannel | eintVIC_ENABLE;
+			VICIntEnable |= ( 1UL << ulChannel );
+
+			xReturn = pdPASS;
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEintClose( eEintLine eLine )
+{
+unsigned long ulBit = 1UL << ( unsigned long ) eLine;
+
+	portENTER_CRITICAL();
+	{
+		VICIntEnClr = 1UL << ( eintVIC_FIRST_CHANNEL + ( unsigned long ) eLine );
+		( &VICVectCntl0 )[ eintVIC_FIRST_SLOT + eLine ] = 0UL;
+		ulOpenLines &= ~ulBit;
+		eintWRITE( eintEXTWAKE, eintREAD( eintEXTWAKE ) & ~ulBit );
+		eintWRITE( eintEXTINT, ulBit );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vEintArm( eEintLine eLine )
+{
+unsigned long ulBit = 1UL << ( unsigned long ) eLine;
+
+	portENTER_CRITICAL();
+	{
+		if( ( ulOpenLines & ulBit ) != 0UL )
+		{
+			/* If the level is still there the flag sets again at once and
+			the interrupt is taken as soon as it is unmasked. */
+			eintWRITE( eintEXTINT, ulBit );
+			VICIntEnable |= 1UL << ( eintVIC_FIRST_CHANNEL + ( unsigned long ) eLine );
+		}
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulEintDropped( eEintLine eLine )
+{
+	return xLines[ eLine ].ulDropped;
+}
+/*-----------------------------------------------------------*/
+
+void vEint_ISRHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulPending, ulBit;
+unsigned portBASE_TYPE uxLine;
+xEintLine *pxLine;
+xEintEvent xEvent;
+
+	/* Every open line that is pending is served, whichever of the four 
+	vectors got here. */
+	ulPending = eintREAD( eintEXTINT ) & ulOpenLines;
+	xEvent.xTime = xTaskGetTickCountFromISR();
+
+	for( uxLine = 0; uxLine < eintNUM_LINES; uxLine++ )
+	{
+		ulBit = 1UL << uxLine;
+
+		if( ( ulPending & ulBit ) == 0UL )
+		{
+			continue;
+		}
+
+		pxLine = &xLines[ uxLine ];
+
+		/* A level holds the flag set, so the line is masked until the task
+		has dealt with it and calls vEintArm(). */
+		if( pxLine->xLevel != pdFALSE )
+		{
+			VICIntEnClr = 1UL << ( eintVIC_FIRST_CHANNEL + uxLine );
+		}
+
+		eintWRITE( eintEXTINT, ulBit );
+
+		if( pxLine->xTask != NULL )
+		{
+			xTaskNotifyFromISR( pxLine->xTask, ulBit, eSetBits, &xHigherPriorityTaskWoken );
+		}
+
+		if( pxLine->xQueue != NULL )
+		{
+			xEvent.ucLine = ( unsigned char ) uxLine;
+
+			if( xQueueSendFromISR( pxLine->xQueue, &xEvent, &xHigherPriorityTaskWoken ) != pdPASS )
+			{
+				pxLine->ulDropped++;
+			}
+		}
+	}
+
+	/* Clear the interrupt in the VIC. */
+	VICVectAddr = eintCLEAR_VIC_INTERRUPT;
+
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
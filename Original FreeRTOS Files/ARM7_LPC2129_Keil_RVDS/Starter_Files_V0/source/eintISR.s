@@ -0,0 +1,57 @@
+;/*
+; * FreeRTOS V202012.00
+; * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+; *
+; * Permission is hereby granted, free of charge, to any person obtaining a copy of
+; * this software and associated documentation files (the "Software"), to deal in
+; * the Software without restriction, including without limitation the rights to
+; * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+; * the Software, and to permit persons to whom the Software is furnished to do so,
+; * subject to the following conditions:
+; *
+; * The above copyright notice and this permission notice shall be included in all
+; * copies or substantial portions of the Software.
+; *
+; * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+; * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+; * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+; * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+; * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+; *
+; * http://www.FreeRTOS.org
+; * http://aws.amazon.com/freertos
+; *
+; * 1 tab == 4 spaces!
+; */
+
+	INCLUDE portmacro.inc
+
+	;External interrupt entry point, shared by EINT0 to EINT3.  As in
+	;serialISR.s, the wrapper saves the context of the interrupted task, calls
+	;the C handler (vEint_ISRHandler() in eint.c), which notifies the waiting
+	;tasks, and restores the context of whichever task is to run next.
+	IMPORT vEint_ISRHandler
+	EXPORT vEint_ISREntry
+
+	;/* Interrupt entry must always be in ARM mode. */
+	ARM
+	AREA	|.text|, CODE, READONLY
+
+
+vEint_ISREntry
+
+	PRESERVE8
+
+	; Save the context of the interrupted task.
+	portSAVE_CONTEXT
+
+	; Call the C handler function - defined within eint.c.
+	LDR R0, =vEint_ISRHandler
+	MOV LR, PC
+	BX R0
+
+	; Restore the context of the task selected to run next.
+	portRESTORE_CONTEXT
+
+	END
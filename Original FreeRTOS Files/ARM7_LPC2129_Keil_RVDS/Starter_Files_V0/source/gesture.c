@@ -0,0 +1,108 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Press classifier.  Everything is worked out from the tick counts the 
+ * debouncer stamps on the press and release edges, so the answer is ready
+ * the moment the button comes up and a re-press straight after a release is
+ * not missed.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo application includes. */
+#include "GPIO.h"
+#include "debounce.h"
+#include "gesture.h"
+
+/*-----------------------------------------------------------*/
+
+void vGestureInit( xGesture *pxGesture, unsigned long ulPin, const xGestureThresholds *pxThresholds )
+{
+	pxGesture->pxThresholds = pxThresholds;
+	pxGesture->ulPin = ulPin;
+	pxGesture->xPressedAt = 0;
+	pxGesture->xClickReleasedAt = 0;
+	pxGesture->xHeld = 0;
+	pxGesture->xPressed = pdFALSE;
+	pxGesture->xClickPending = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+eGesture eGestureFeed( xGesture *pxGesture, const xDebounceEvent *pxEvent )
+{
+const xGestureThresholds *pxThresholds = pxGesture->pxThresholds;
+eGesture eReturn = gestureNONE;
+
+	if( ( pxEvent->ulPressed & pxGesture->ulPin ) != 0UL )
+	{
+		pxGesture->xPressedAt = pxEvent->xTime;
+		pxGesture->xPressed = pdTRUE;
+	}
+	else if( ( ( pxEvent->ulReleased & pxGesture->ulPin ) != 0UL ) && ( pxGesture->xPressed != pdFALSE ) )
+	{
+		pxGesture->xPressed = pdFALSE;
+		pxGesture->xHeld = pxEvent->xTime - pxGesture->xPressedAt;
+
+		if( pxGesture->xHeld >= pxThresholds->xVeryLongPress )
+		{
+			eReturn = gestureVERY_LONG_PRESS;
+			pxGesture->xClickPending = pdFALSE;
+		}
+		else if( pxGesture->xHeld >= pxThresholds->xLongPress )
+		{
+			eReturn = gestureLONG_PRESS;
+			pxGesture->xClickPending = pdFALSE;
+		}
+		else if( ( pxGesture->xClickPending != pdFALSE ) && ( ( pxGesture->xPressedAt - pxGesture->xClickReleasedAt ) < pxThresholds->xDoubleClickGap ) )
+		{
+			/* Unsigned difference, so a tick count that wrapped between the
+			two clicks still gives the right gap.  A third click starts a new
+			pair rather than making another double click. */
+			eReturn = gestureDOUBLE_CLICK;
+			pxGesture->xClickPending = pdFALSE;
+		}
+		else
+		{
+			eReturn = gestureCLICK;
+			pxGesture->xClickReleasedAt = pxEvent->xTime;
+			pxGesture->xClickPending = pdTRUE;
+		}
+	}
+
+	return eReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xGestureHeld( const xGesture *pxGesture )
+{
+	return pxGesture->xHeld;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,443 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Allocator benchmark under create and delete churn.
+ *
+ * vStartHeapBenchTask() creates a task that keeps hbenchSLOTS slots, each 
+ * empty or holding a task, a queue or a bare pvPortMalloc() block.  Every 
+ * step it picks a slot at random and either fills it with something picked at
+ * random or empties it, so objects of different sizes come and go in an 
+ * order that leaves the heap in a different state each time.  The random 
+ * numbers start from the same seed on every build, so two builds that differ
+ * only in their heap see the same calls.  Every few seconds it writes:
+ *
+ *     hbench run=1 heap=pool hz=60000000 steps=64 failed=0 free=1024
+ *     hbench name=task_create min=1530 avg=1592 max=1660
+ *     ...
+ *     hbench class=TCB size=104 blocks=8 used=5 peak=8 exhausted=0
+ *     ...
+ *     hbench end
+ *
+ * Times are in counts of hz, with the cost of reading the count taken off.
+ * failed is the number of creates that found no memory since the start and
+ * free what xPortGetFreeHeapSize() says.  The class lines are the pool 
+ * occupancy, see poolheap.h, and only come from the pool heap.
+ *
+ *  task_create, task_delete	xTaskCreate() of a configMINIMAL_STACK_SIZE
+ *								task and vTaskDelete() of one that is blocked.
+ *  queue_create, queue_delete	xQueueCreate() of one to four longs and
+ *								vQueueDelete().
+ *  malloc, free				pvPortMalloc() of a TCB, a stack or a small
+ *								block, and vPortFree().
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "timebase.h"
+#include "poolheap.h"
+#include "strfmt.h"
+#include "heapbench.h"
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+#define hbenchSTACK_SIZE			configMINIMAL_STACK_SIZE
+#define hbenchSLOTS					( 6 )
+#define hbenchSTEPS					( 64 )
+#define hbenchSAMPLES				( 32 )
+#define hbenchPERIOD				( ( TickType_t ) 5000 / portTICK_PERIOD_MS )
+#define hbenchREPORT_LENGTH			( 80 )
+#define hbenchSEED					( 0x2545F491UL )
+
+#if( poolheapENABLE == 1 )
+	#define hbenchHEAP_NAME			"pool"
+#else
+	#define hbenchHEAP_NAME			"kernel"
+#endif
+
+/* X( eMeasurement, "name" ), in the order they are reported. */
+#define hbenchMEASUREMENTS( X )							\
+	X( hbTASK_CREATE,		"task_create" )				\
+	X( hbTASK_DELETE,		"task_delete" )				\
+	X( hbQUEUE_CREATE,		"queue_create" )			\
+	X( hbQUEUE_DELETE,		"queue_delete" )			\
+	X( hbMALLOC,			"malloc" )					\
+	X( hbFREE,				"free" )
+
+#define hbenchENUM( eMeasurement, pcName )		eMeasurement,
+#define hbenchNAME( eMeasurement, pcName )		pcName,
+
+typedef enum
+{
+	hbenchMEASUREMENTS( hbenchENUM )
+	hbNUM_MEASUREMENTS
+} eHeapBenchMeasurement;
+
+typedef enum
+{
+	hbSLOT_EMPTY = 0,
+	hbSLOT_TASK,
+	hbSLOT_QUEUE,
+	hbSLOT_BLOCK,
+	hbNUM_SLOT_KINDS
+} eHeapBenchSlotKind;
+
+typedef struct HBENCH_SLOT
+{
+	eHeapBenchSlotKind eKind;
+	void *pvObject;
+} xHeapBenchSlot;
+
+typedef struct HBENCH_RESULT
+{
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long ulTotal;
+	unsigned long ulSamples;
+} xHeapBenchResult;
+
+/*-----------------------------------------------------------*/
+
+static void vHeapBenchTask( void *pvParameters );
+
+/*
+ * What the benchmark creates tasks of.  Blocks as soon as it runs.
+ */
+static void vHeapBenchDormantTask( void *pvParameters );
+
+/*
+ * Fill or empty pxSlot, timing the call that does it.
+ */
+static void prvFill( xHeapBenchSlot *pxSlot );
+static void prvEmpty( xHeapBenchSlot *pxSlot );
+
+/*
+ * A xorshift generator, so the sequence is the same on every build.
+ */
+static unsigned long prvRandom( void );
+
+/*
+ * Takes the cost of reading the count off ulCounts and adds it to the 
+ * results of eMeasurement.
+ */
+static void prvRecord( eHeapBenchMeasurement eMeasurement, unsigned long ulCounts );
+static void prvReport( unsigned long ulRun );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcNames[ hbNUM_MEASUREMENTS ] =
+{
+	hbenchMEASUREMENTS( hbenchNAME )
+};
+
+/* The sizes of bare block to ask for: a TCB, a stack and a small block. */
+static const size_t xBlockSizes[] =
+{
+	sizeof( StaticTask_t ),
+	( size_t ) hbenchSTACK_SIZE * sizeof( StackType_t ),
+	( size_t ) 24
+};
+
+static xHeapBenchResult xResults[ hbNUM_MEASUREMENTS ];
+static unsigned long ulOverhead;
+static unsigned long ulFailed = 0;
+static unsigned long ulSeed = hbenchSEED;
+
+static xComPortHandle xReportPort = NULL;
+static xHeapBenchSlot xSlots[ hbenchSLOTS ];
+
+/* Kept off the task's stack, which is only the minimal size. */
+static char cReport[ hbenchREPORT_LENGTH ];
+
+/*-----------------------------------------------------------*/
+
+void vStartHeapBenchTask( xComPortHandle pxPort, unsigned portBASE_TYPE uxPriority )
+{
+	xReportPort = pxPort;
+
+	/* Above the tasks it creates, so none of them runs inside a timing. */
+	configASSERT( uxPriority > tskIDLE_PRIORITY );
+
+	xTaskCreate( vHeapBenchTask, "HBench", hbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vHeapBenchTask( void *pvParameters )
+{
+unsigned long ulStart, ulValue, ulRun = 0;
+unsigned portBASE_TYPE ux;
+xHeapBenchSlot *pxSlot;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulRun++;
+
+		for( ux = 0; ux < hbNUM_MEASUREMENTS; ux++ )
+		{
+			xResults[ ux ].ulMin = ~0UL;
+			xResults[ ux ].ulMax = 0UL;
+			xResults[ ux ].ulTotal = 0UL;
+			xResults[ ux ].ulSamples = 0UL;
+		}
+
+		/* The cheapest back to back read of the count is taken off every 
+		sample. */
+		ulOverhead = ~0UL;
+		for( ux = 0; ux < hbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			ulValue = ulTimebaseNow() - ulStart;
+
+			if( ulValue < ulOverhead )
+			{
+				ulOverhead = ulValue;
+			}
+		}
+
+		/* The slots are left as they are between runs, so the heap carries 
+		its history from one run to the next. */
+		for( ux = 0; ux < hbenchSTEPS; ux++ )
+		{
+			pxSlot = &( xSlots[ prvRandom() % hbenchSLOTS ] );
+
+			if( pxSlot->eKind == hbSLOT_EMPTY )
+			{
+				prvFill( pxSlot );
+			}
+			else
+			{
+				prvEmpty( pxSlot );
+			}
+		}
+
+		prvReport( ulRun );
+		vTaskDelay( hbenchPERIOD );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vHeapBenchDormantTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFill( xHeapBenchSlot *pxSlot )
+{
+unsigned long ulStart, ulCounts;
+eHeapBenchSlotKind eKind;
+TaskHandle_t xTask = NULL;
+size_t xSize;
+
+	eKind = ( eHeapBenchSlotKind ) ( ( prvRandom() % ( hbNUM_SLOT_KINDS - 1 ) ) + 1 );
+
+	switch( eKind )
+	{
+		case hbSLOT_TASK	:	ulStart = ulTimebaseNow();
+								if( xTaskCreate( vHeapBenchDormantTask, "Dormant", hbenchSTACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask ) != pdPASS )
+								{
+									xTask = NULL;
+								}
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbTASK_CREATE, ulCounts );
+								pxSlot->pvObject = ( void * ) xTask;
+								break;
+
+		case hbSLOT_QUEUE	:	xSize = ( size_t ) ( ( prvRandom() % 4UL ) + 1UL );
+								ulStart = ulTimebaseNow();
+								pxSlot->pvObject = ( void * ) xQueueCreate( ( UBaseType_t ) xSize, sizeof( unsigned long ) );
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbQUEUE_CREATE, ulCounts );
+								break;
+
+		default				:	xSize = xBlockSizes[ prvRandom() % ( sizeof( xBlockSizes ) / sizeof( xBlockSizes[ 0 ] ) ) ];
+								ulStart = ulTimebaseNow();
+								pxSlot->pvObject = pvPortMalloc( xSize );
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbMALLOC, ulCounts );
+								break;
+	}
+
+	if( pxSlot->pvObject != NULL )
+	{
+		pxSlot->eKind = eKind;
+	}
+	else
+	{
+		ulFailed++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEmpty( xHeapBenchSlot *pxSlot )
+{
+unsigned long ulStart, ulCounts;
+
+	switch( pxSlot->eKind )
+	{
+		case hbSLOT_TASK	:	ulStart = ulTimebaseNow();
+								vTaskDelete( ( TaskHandle_t ) pxSlot->pvObject );
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbTASK_DELETE, ulCounts );
+								break;
+
+		case hbSLOT_QUEUE	:	ulStart = ulTimebaseNow();
+								vQueueDelete( ( QueueHandle_t ) pxSlot->pvObject );
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbQUEUE_DELETE, ulCounts );
+								break;
+
+		default				:	ulStart = ulTimebaseNow();
+								vPortFree( pxSlot->pvObject );
+								ulCounts = ulTimebaseNow() - ulStart;
+								prvRecord( hbFREE, ulCounts );
+								break;
+	}
+
+	pxSlot->eKind = hbSLOT_EMPTY;
+	pxSlot->pvObject = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulSeed ^= ulSeed << 13;
+	ulSeed ^= ( ulSeed & 0xFFFFFFFFUL ) >> 17;
+	ulSeed ^= ulSeed << 5;
+	ulSeed &= 0xFFFFFFFFUL;
+
+	return ulSeed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( eHeapBenchMeasurement eMeasurement, unsigned long ulCounts )
+{
+xHeapBenchResult *pxResult = &xResults[ eMeasurement ];
+
+	ulCounts = ( ulCounts > ulOverhead ) ? ( ulCounts - ulOverhead ) : 0UL;
+
+	if( ulCounts < pxResult->ulMin )
+	{
+		pxResult->ulMin = ulCounts;
+	}
+
+	if( ulCounts > pxResult->ulMax )
+	{
+		pxResult->ulMax = ulCounts;
+	}
+
+	pxResult->ulTotal += ulCounts;
+	pxResult->ulSamples++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( unsigned long ulRun )
+{
+xHeapBenchResult *pxResult;
+char *pcNext;
+unsigned portBASE_TYPE ux;
+#if( poolheapENABLE == 1 )
+	xPoolStats xStats;
+#endif
+
+	pcNext = pcStrFmtAppendString( cReport, "hbench run=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, ulRun );
+	pcNext = pcStrFmtAppendString( pcNext, " heap=" hbenchHEAP_NAME " hz=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, timebaseHZ );
+	pcNext = pcStrFmtAppendString( pcNext, " steps=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, hbenchSTEPS );
+	pcNext = pcStrFmtAppendString( pcNext, " failed=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, ulFailed );
+	pcNext = pcStrFmtAppendString( pcNext, " free=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, ( unsigned long ) xPortGetFreeHeapSize() );
+	pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+	xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), hbenchPERIOD );
+
+	for( ux = 0; ux < hbNUM_MEASUREMENTS; ux++ )
+	{
+		pxResult = &xResults[ ux ];
+
+		if( pxResult->ulSamples == 0UL )
+		{
+			continue;
+		}
+
+		pcNext = pcStrFmtAppendString( cReport, "hbench name=" );
+		pcNext = pcStrFmtAppendString( pcNext, pcNames[ ux ] );
+		pcNext = pcStrFmtAppendString( pcNext, " min=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulMin );
+		pcNext = pcStrFmtAppendString( pcNext, " avg=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulTotal / pxResult->ulSamples );
+		pcNext = pcStrFmtAppendString( pcNext, " max=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulMax );
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+		xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), hbenchPERIOD );
+	}
+
+	#if( poolheapENABLE == 1 )
+	{
+		for( ux = 0; ux < uxPoolClasses(); ux++ )
+		{
+			vPoolGetStats( ux, &xStats );
+
+			pcNext = pcStrFmtAppendString( cReport, "hbench class=" );
+			pcNext = pcStrFmtAppendString( pcNext, xStats.pcName );
+			pcNext = pcStrFmtAppendString( pcNext, " size=" );
+			pcNext = pcStrFmtAppendNumber( pcNext, ( unsigned long ) xStats.xBlockSize );
+			pcNext = pcStrFmtAppendString( pcNext, " blocks=" );
+			pcNext = pcStrFmtAppendNumber( pcNext, xStats.uxBlocks );
+			pcNext = pcStrFmtAppendString( pcNext, " used=" );
+			pcNext = pcStrFmtAppendNumber( pcNext, xStats.uxUsed );
+			pcNext = pcStrFmtAppendString( pcNext, " peak=" );
+			pcNext = pcStrFmtAppendNumber( pcNext, xStats.uxPeak );
+			pcNext = pcStrFmtAppendString( pcNext, " exhausted=" );
+			pcNext = pcStrFmtAppendNumber( pcNext, xStats.ulExhausted );
+			pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+			xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), hbenchPERIOD );
+		}
+	}
+	#endif
+
+	pcNext = pcStrFmtAppendString( cReport, "hbench end\r\n" );
+	xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), hbenchPERIOD );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
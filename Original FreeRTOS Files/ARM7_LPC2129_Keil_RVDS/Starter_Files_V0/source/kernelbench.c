@@ -0,0 +1,479 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Micro-benchmarks of the kernel primitives the applications rely on, timed
+ * with the Timer1 count from timebase.c.
+ *
+ * vStartKernelBenchTasks() creates three tasks.  "KBench" takes the 
+ * measurements.  "KBHigh", one priority above it, and "KBPeer", at the same
+ * priority, are the other ends of the wake up and switch measurements.  Each
+ * measurement is taken kbenchSAMPLES times per run, and every run is reported
+ * as one line per measurement:
+ *
+ *     kbench run=1 hz=60000000 samples=32
+ *     kbench name=queue_send min=412 avg=420 max=1035
+ *     ...
+ *     kbench end
+ *
+ * Times are in counts of hz, with the cost of reading the count taken off.
+ *
+ *  queue_send, queue_receive	xQueueSend() and xQueueReceive() that neither
+ *								block nor wake a task.
+ *  sem_give, sem_take			The same for a binary semaphore.
+ *  notify_give, notify_take	xTaskNotifyGive() to a task that is not 
+ *								waiting, and ulTaskNotifyTake() with a 
+ *								notification pending.
+ *  yield						taskYIELD() with nothing else ready.
+ *  switch						taskYIELD() until another task of the same
+ *								priority runs.
+ *  sem_wake, notify_wake,		Give, notify or send to a higher priority task
+ *  queue_wake					blocked on it, until that task runs.
+ *  isr_wake					From the start of an ISR until the task it 
+ *								notified runs.
+ *  irq_entry					From the Timer1 match until its ISR starts.  
+ *								Only reported where the count is Timer1's.
+ *
+ * The wake up measurements rely on a readied task running straight away, so 
+ * the scheduler must be preemptive.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "serial.h"
+#include "timebase.h"
+#include "strfmt.h"
+#include "kernelbench.h"
+
+#define kbenchSTACK_SIZE			configMINIMAL_STACK_SIZE
+#define kbenchSAMPLES				( 32 )
+#define kbenchPERIOD				( ( TickType_t ) 5000 / portTICK_PERIOD_MS )
+#define kbenchREPORT_LENGTH			( 80 )
+
+/* How far ahead of now the Timer1 alarm is set for isr_wake. */
+#define kbenchALARM_DELAY			( ( unsigned long ) 600 )
+
+#define kbenchVIC_CHANNEL			( ( unsigned long ) 5 )		/* Timer1. */
+#define kbenchVIC_SLOT				( 3 )
+#define kbenchVIC_ENABLE			( ( unsigned long ) 0x0020 )
+#define kbenchCLEAR_VIC_INTERRUPT	( ( unsigned long ) 0 )
+
+/* X( eMeasurement, "name" ), in the order they are reported. */
+#define kbenchMEASUREMENTS( X )							\
+	X( kbQUEUE_SEND,		"queue_send" )				\
+	X( kbQUEUE_RECEIVE,		"queue_receive" )			\
+	X( kbSEM_GIVE,			"sem_give" )				\
+	X( kbSEM_TAKE,			"sem_take" )				\
+	X( kbNOTIFY_GIVE,		"notify_give" )				\
+	X( kbNOTIFY_TAKE,		"notify_take" )				\
+	X( kbYIELD,				"yield" )					\
+	X( kbSWITCH,			"switch" )					\
+	X( kbSEM_WAKE,			"sem_wake" )				\
+	X( kbNOTIFY_WAKE,		"notify_wake" )				\
+	X( kbQUEUE_WAKE,		"queue_wake" )				\
+	X( kbISR_WAKE,			"isr_wake" )				\
+	X( kbIRQ_ENTRY,			"irq_entry" )
+
+#define kbenchENUM( eMeasurement, pcName )		eMeasurement,
+#define kbenchNAME( eMeasurement, pcName )		pcName,
+
+typedef enum
+{
+	kbenchMEASUREMENTS( kbenchENUM )
+	kbNUM_MEASUREMENTS
+} eKernelBenchMeasurement;
+
+typedef struct KBENCH_RESULT
+{
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long ulTotal;
+	unsigned long ulSamples;
+} xKernelBenchResult;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The asm wrapper that saves the task context before calling 
+ * vKernelBench_ISRHandler().
+ */
+extern void vKernelBench_ISREntry( void );
+
+static void vKernelBenchTask( void *pvParameters );
+static void vKernelBenchHighTask( void *pvParameters );
+static void vKernelBenchPeerTask( void *pvParameters );
+
+/*
+ * Takes the cost of reading the count off ulCounts and adds it to the 
+ * results of eMeasurement.
+ */
+static void prvRecord( eKernelBenchMeasurement eMeasurement, unsigned long ulCounts );
+static void prvReport( unsigned long ulRun );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcNames[ kbNUM_MEASUREMENTS ] =
+{
+	kbenchMEASUREMENTS( kbenchNAME )
+};
+
+static xKernelBenchResult xResults[ kbNUM_MEASUREMENTS ];
+static unsigned long ulOverhead;
+
+static xComPortHandle xReportPort = NULL;
+static TaskHandle_t xBenchTask = NULL, xHighTask = NULL, xPeerTask = NULL;
+
+/* Exercised without anyone waiting on them. */
+static QueueHandle_t xQueue = NULL;
+static SemaphoreHandle_t xSemaphore = NULL;
+
+/* What the high priority task waits on. */
+static QueueHandle_t xWakeQueue = NULL;
+static SemaphoreHandle_t xWakeSemaphore = NULL;
+
+/* Stamped by the other tasks and the ISR as they run. */
+static volatile unsigned long ulWokenAt = 0, ulWakeCount = 0;
+static volatile unsigned long ulSwitchedInAt = 0;
+static volatile unsigned long ulISREnteredAt = 0;
+
+/* Kept off the task's stack, which is only the minimal size. */
+static char cReport[ kbenchREPORT_LENGTH ];
+
+/* Storage for the queues, semaphores and tasks above. */
+static unsigned long ulQueueStorage[ 1 ], ulWakeQueueStorage[ 1 ];
+static StaticQueue_t xQueueBuffer, xWakeQueueBuffer;
+static StaticSemaphore_t xSemaphoreBuffer, xWakeSemaphoreBuffer;
+static StackType_t xBenchStack[ kbenchSTACK_SIZE ], xHighStack[ kbenchSTACK_SIZE ], xPeerStack[ kbenchSTACK_SIZE ];
+static StaticTask_t xBenchTCB, xHighTCB, xPeerTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartKernelBenchTasks( xComPortHandle pxPort, unsigned portBASE_TYPE uxPriority )
+{
+	xReportPort = pxPort;
+
+	xQueue = xQueueCreateStatic( 1, sizeof( unsigned long ), ( uint8_t * ) ulQueueStorage, &xQueueBuffer );
+	xWakeQueue = xQueueCreateStatic( 1, sizeof( unsigned long ), ( uint8_t * ) ulWakeQueueStorage, &xWakeQueueBuffer );
+	xSemaphore = xSemaphoreCreateBinaryStatic( &xSemaphoreBuffer );
+	xWakeSemaphore = xSemaphoreCreateBinaryStatic( &xWakeSemaphoreBuffer );
+
+	/* Timer1's match interrupt drives isr_wake. */
+	portENTER_CRITICAL();
+	{
+		VICIntSelect &= ~( 1UL << kbenchVIC_CHANNEL );
+		VICIntEnable |= ( 1UL << kbenchVIC_CHANNEL );
+		( &VICVectAddr0 )[ kbenchVIC_SLOT ] = ( unsigned long ) vKernelBench_ISREntry;
+		( &VICVectCntl0 )[ kbenchVIC_SLOT ] = kbenchVIC_CHANNEL | kbenchVIC_ENABLE;
+	}
+	portEXIT_CRITICAL();
+
+	xBenchTask = xTaskCreateStatic( vKernelBenchTask, "KBench", kbenchSTACK_SIZE, NULL, uxPriority, xBenchStack, &xBenchTCB );
+	xHighTask = xTaskCreateStatic( vKernelBenchHighTask, "KBHigh", kbenchSTACK_SIZE, NULL, uxPriority + 1, xHighStack, &xHighTCB );
+	xPeerTask = xTaskCreateStatic( vKernelBenchPeerTask, "KBPeer", kbenchSTACK_SIZE, NULL, uxPriority, xPeerStack, &xPeerTCB );
+}
+/*-----------------------------------------------------------*/
+
+void vKernelBench_ISRHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	ulISREnteredAt = ulTimebaseNow();
+
+	vTimebaseClearAlarm();
+	vTaskNotifyGiveFromISR( xHighTask, &xHigherPriorityTaskWoken );
+
+	/* Clear the interrupt in the VIC. */
+	VICVectAddr = kbenchCLEAR_VIC_INTERRUPT;
+
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void vKernelBenchTask( void *pvParameters )
+{
+unsigned long ulStart, ulValue = 0, ulWakes, ulRun = 0;
+unsigned long ulAlarm;
+unsigned portBASE_TYPE ux;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulRun++;
+
+		for( ux = 0; ux < kbNUM_MEASUREMENTS; ux++ )
+		{
+			xResults[ ux ].ulMin = ~0UL;
+			xResults[ ux ].ulMax = 0UL;
+			xResults[ ux ].ulTotal = 0UL;
+			xResults[ ux ].ulSamples = 0UL;
+		}
+
+		/* The cheapest back to back read of the count is taken off every 
+		sample. */
+		ulOverhead = ~0UL;
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			ulValue = ulTimebaseNow() - ulStart;
+
+			if( ulValue < ulOverhead )
+			{
+				ulOverhead = ulValue;
+			}
+		}
+
+		/* Nobody waits on these, so none of them switches task. */
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			xQueueSend( xQueue, &ulValue, 0 );
+			prvRecord( kbQUEUE_SEND, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			xQueueReceive( xQueue, &ulValue, 0 );
+			prvRecord( kbQUEUE_RECEIVE, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			xSemaphoreGive( xSemaphore );
+			prvRecord( kbSEM_GIVE, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			xSemaphoreTake( xSemaphore, 0 );
+			prvRecord( kbSEM_TAKE, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			xTaskNotifyGive( xBenchTask );
+			prvRecord( kbNOTIFY_GIVE, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			ulTaskNotifyTake( pdTRUE, 0 );
+			prvRecord( kbNOTIFY_TAKE, ulTimebaseNow() - ulStart );
+
+			ulStart = ulTimebaseNow();
+			taskYIELD();
+			prvRecord( kbYIELD, ulTimebaseNow() - ulStart );
+		}
+
+		/* The peer is readied, but as it has the same priority it only runs
+		when this task yields.  The first yield gets it to its loop. */
+		xTaskNotifyGive( xPeerTask );
+		taskYIELD();
+
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			taskYIELD();
+			prvRecord( kbSWITCH, ulSwitchedInAt - ulStart );
+		}
+
+		/* The high priority task preempts this one inside each call and has
+		stamped ulWokenAt by the time the call returns. */
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			xSemaphoreGive( xWakeSemaphore );
+			prvRecord( kbSEM_WAKE, ulWokenAt - ulStart );
+		}
+
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			xTaskNotifyGive( xHighTask );
+			prvRecord( kbNOTIFY_WAKE, ulWokenAt - ulStart );
+		}
+
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulStart = ulTimebaseNow();
+			xQueueSend( xWakeQueue, &ulValue, 0 );
+			prvRecord( kbQUEUE_WAKE, ulWokenAt - ulStart );
+		}
+
+		/* Here the high priority task preempts the spin below once the ISR
+		has notified it. */
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulWakes = ulWakeCount;
+			ulAlarm = ulTimebaseSetAlarm( kbenchALARM_DELAY );
+
+			while( ulWakeCount == ulWakes )
+			{
+			}
+
+			prvRecord( kbISR_WAKE, ulWokenAt - ulISREnteredAt );
+
+			#if( timebaseFROM_TIMER1 == 1 )
+			{
+				prvRecord( kbIRQ_ENTRY, ulISREnteredAt - ulAlarm );
+			}
+			#else
+			{
+				( void ) ulAlarm;
+			}
+			#endif
+		}
+
+		prvReport( ulRun );
+		vTaskDelay( kbenchPERIOD );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vKernelBenchHighTask( void *pvParameters )
+{
+unsigned long ulValue;
+unsigned portBASE_TYPE ux;
+
+	( void ) pvParameters;
+
+	/* Blocks on the same things, in the same order, as vKernelBenchTask() 
+	wakes it with. */
+	for( ;; )
+	{
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			xSemaphoreTake( xWakeSemaphore, portMAX_DELAY );
+			ulWokenAt = ulTimebaseNow();
+			ulWakeCount++;
+		}
+
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			ulWokenAt = ulTimebaseNow();
+			ulWakeCount++;
+		}
+
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			xQueueReceive( xWakeQueue, &ulValue, portMAX_DELAY );
+			ulWokenAt = ulTimebaseNow();
+			ulWakeCount++;
+		}
+
+		/* Notified from the ISR. */
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			ulWokenAt = ulTimebaseNow();
+			ulWakeCount++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vKernelBenchPeerTask( void *pvParameters )
+{
+unsigned portBASE_TYPE ux;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		/* Each yield returns when the benchmark task yields for its next 
+		sample.  After the last one this task blocks again, which lets the
+		benchmark task carry on. */
+		for( ux = 0; ux < kbenchSAMPLES; ux++ )
+		{
+			taskYIELD();
+			ulSwitchedInAt = ulTimebaseNow();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( eKernelBenchMeasurement eMeasurement, unsigned long ulCounts )
+{
+xKernelBenchResult *pxResult = &xResults[ eMeasurement ];
+
+	ulCounts = ( ulCounts > ulOverhead ) ? ( ulCounts - ulOverhead ) : 0UL;
+
+	if( ulCounts < pxResult->ulMin )
+	{
+		pxResult->ulMin = ulCounts;
+	}
+
+	if( ulCounts > pxResult->ulMax )
+	{
+		pxResult->ulMax = ulCounts;
+	}
+
+	pxResult->ulTotal += ulCounts;
+	pxResult->ulSamples++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( unsigned long ulRun )
+{
+xKernelBenchResult *pxResult;
+char *pcNext;
+unsigned portBASE_TYPE ux;
+
+	pcNext = pcStrFmtAppendString( cReport, "kbench run=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, ulRun );
+	pcNext = pcStrFmtAppendString( pcNext, " hz=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, timebaseHZ );
+	pcNext = pcStrFmtAppendString( pcNext, " samples=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, kbenchSAMPLES );
+	pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+	xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), kbenchPERIOD );
+
+	for( ux = 0; ux < kbNUM_MEASUREMENTS; ux++ )
+	{
+		pxResult = &xResults[ ux ];
+
+		if( pxResult->ulSamples == 0UL )
+		{
+			continue;
+		}
+
+		pcNext = pcStrFmtAppendString( cReport, "kbench name=" );
+		pcNext = pcStrFmtAppendString( pcNext, pcNames[ ux ] );
+		pcNext = pcStrFmtAppendString( pcNext, " min=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulMin );
+		pcNext = pcStrFmtAppendString( pcNext, " avg=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulTotal / pxResult->ulSamples );
+		pcNext = pcStrFmtAppendString( pcNext, " max=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, pxResult->ulMax );
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+		xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), kbenchPERIOD );
+	}
+
+	pcNext = pcStrFmtAppendString( cReport, "kbench end\r\n" );
+	xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), kbenchPERIOD );
+}
+/*-----------------------------------------------------------*/
+
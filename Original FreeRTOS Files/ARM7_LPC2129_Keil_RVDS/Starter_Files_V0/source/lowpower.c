@@ -0,0 +1,217 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tickless idle on Timer0, the timer the port takes the tick from.
+ *
+ * The port runs Timer0 from the peripheral clock with no prescaler, resets 
+ * it on MR0 and raises the tick at each reset.  To sleep for several ticks
+ * MR0 is moved out to the end of the last of them and the count left to run
+ * on from wherever the current tick had got to, so the time already spent in
+ * it is not lost.  On waking the count says how many whole ticks went by and
+ * what is left of the current one becomes the count of the next.  Timer0 is
+ * stopped only while its registers are read and rewritten, which loses a few
+ * peripheral clocks a sleep.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "lowpower.h"
+
+#if( configUSE_TICKLESS_IDLE == 2 )
+
+#define lowpowerTIMER0_BASE			( ( unsigned long ) 0xE0004000 )
+
+/* Register offsets, as timebase.c. */
+#define timIR						( ( unsigned long ) 0x00 )
+#define timTCR						( ( unsigned long ) 0x04 )
+#define timTC						( ( unsigned long ) 0x08 )
+#define timMR0						( ( unsigned long ) 0x18 )
+
+#define timTCR_ENABLE				( ( unsigned long ) 0x01 )
+#define timIR_MR0					( ( unsigned long ) 0x01 )
+
+/* Register access.  The host build supplies its own, see serial.c. */
+#ifndef timREAD
+	#define timREAD( ulBase, ulOffset )				( *( ( volatile unsigned long * ) ( ( ulBase ) + ( ulOffset ) ) ) )
+	#define timWRITE( ulBase, ulOffset, ulValue )	( timREAD( ( ulBase ), ( ulOffset ) ) = ( ulValue ) )
+#endif
+
+/* The MR0 value the port sets up the tick with. */
+#define lowpowerCOUNTS_PER_TICK		( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/* The longest sleep.  MR0 could hold twice as long, but Timer1 counts at the
+same rate and wraps every 2^32 counts, and ulTimebaseMicros() only keeps up
+with it when the context switch calls it.  Half the wrap leaves the other
+half for the time between the last switch and the sleep, and between waking
+and the next switch. */
+#define lowpowerMAX_TICKS			( ( TickType_t ) ( 0x7FFFFFFFUL / lowpowerCOUNTS_PER_TICK ) )
+
+/* Timer0 is VIC channel 4, EINT0 to EINT3 are 14 to 17. */
+#define lowpowerTIMER0_CHANNEL_BIT	( ( unsigned long ) 1 << 4 )
+#define lowpowerEINT_CHANNEL_BITS	( ( unsigned long ) 0x0F << 14 )
+
+#define lowpowerPCON_IDLE			( ( unsigned long ) 0x01 )
+#define lowpowerPCON_POWER_DOWN		( ( unsigned long ) 0x02 )
+
+#define lowpowerPLLCON_ENABLE		( ( unsigned long ) 0x01 )
+#define lowpowerPLLCON_CONNECT		( ( unsigned long ) 0x02 )
+#define lowpowerPLLSTAT_LOCK		( ( unsigned long ) 0x0400 )
+
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvOnlyEintsWake( void );
+static void prvPowerDown( void );
+
+static xLowPowerStats xStats;
+
+/*-----------------------------------------------------------*/
+
+void vLowPowerSleep( TickType_t xExpectedIdleTime )
+{
+eSleepModeStatus eStatus;
+unsigned long ulCount;
+TickType_t xCompleteTicks;
+
+	if( xExpectedIdleTime > lowpowerMAX_TICKS )
+	{
+		xExpectedIdleTime = lowpowerMAX_TICKS;
+	}
+
+	/* Interrupts first, so a tick cannot slip in between stopping Timer0 
+	and looking at it. */
+	portDISABLE_INTERRUPTS();
+	timWRITE( lowpowerTIMER0_BASE, timTCR, 0UL );
+
+	eStatus = eTaskConfirmSleepModeStatus();
+
+	/* A task became ready, or a tick is waiting to be taken. */
+	if( ( eStatus == eAbortSleep ) || ( ( timREAD( lowpowerTIMER0_BASE, timIR ) & timIR_MR0 ) != 0UL ) )
+	{
+		timWRITE( lowpowerTIMER0_BASE, timTCR, timTCR_ENABLE );
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	if( ( eStatus == eNoTasksWaitingTimeout ) && ( prvOnlyEintsWake() != pdFALSE ) )
+	{
+		/* Timer0 stops with the oscillator, and as nothing waits on the 
+		time there are no ticks to make up. */
+		prvPowerDown();
+		xStats.ulSleeps++;
+		xStats.ulPowerDowns++;
+		timWRITE( lowpowerTIMER0_BASE, timTCR, timTCR_ENABLE );
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	/* The count goes on from where the current tick had got to, which is
+	below the new MR0 as xExpectedIdleTime is at least 
+	configEXPECTED_IDLE_TIME_BEFORE_SLEEP. */
+	timWRITE( lowpowerTIMER0_BASE, timMR0, lowpowerCOUNTS_PER_TICK * ( unsigned long ) xExpectedIdleTime );
+	timWRITE( lowpowerTIMER0_BASE, timTCR, timTCR_ENABLE );
+
+	/* Any interrupt the VIC has enabled restarts the processor clock, even
+	with IRQs masked in the CPSR, and execution goes on from here.  The 
+	interrupt is taken once they are unmasked below. */
+	PCON = lowpowerPCON_IDLE;
+
+	timWRITE( lowpowerTIMER0_BASE, timTCR, 0UL );
+	ulCount = timREAD( lowpowerTIMER0_BASE, timTC );
+
+	if( ( timREAD( lowpowerTIMER0_BASE, timIR ) & timIR_MR0 ) != 0UL )
+	{
+		/* The whole sleep went by and Timer0 has already reset.  The tick 
+		interrupt now pending takes the last tick. */
+		xCompleteTicks = xExpectedIdleTime - 1;
+	}
+	else
+	{
+		/* Something else woke the processor part way. */
+		xCompleteTicks = ( TickType_t ) ( ulCount / lowpowerCOUNTS_PER_TICK );
+		timWRITE( lowpowerTIMER0_BASE, timTC, ulCount % lowpowerCOUNTS_PER_TICK );
+	}
+
+	timWRITE( lowpowerTIMER0_BASE, timMR0, lowpowerCOUNTS_PER_TICK );
+	timWRITE( lowpowerTIMER0_BASE, timTCR, timTCR_ENABLE );
+
+	vTaskStepTick( xCompleteTicks );
+	xStats.ulSleeps++;
+	xStats.ulTicksAsleep += ( unsigned long ) xCompleteTicks;
+
+	portENABLE_INTERRUPTS();
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerGetStats( xLowPowerStats *pxStats )
+{
+	portENTER_CRITICAL();
+	{
+		*pxStats = xStats;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvOnlyEintsWake( void )
+{
+	/* Only an external interrupt can wake the processor from power down,
+	so nothing else may be waiting on one, a UART for example. */
+	if( ( VICIntEnable & ~( lowpowerTIMER0_CHANNEL_BIT | lowpowerEINT_CHANNEL_BITS ) ) != 0UL )
+	{
+		return pdFALSE;
+	}
+
+	return ( ( EXTWAKE & ( VICIntEnable >> 14 ) & 0x0FUL ) != 0UL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPowerDown( void )
+{
+	PCON = lowpowerPCON_POWER_DOWN;
+
+	/* The oscillator is back, but the PLL comes out of power down off and 
+	disconnected.  PLLCFG keeps the value Startup.s gave it. */
+	PLLCON = lowpowerPLLCON_ENABLE;
+	PLLFEED = 0xAA;
+	PLLFEED = 0x55;
+
+	while( ( PLLSTAT & lowpowerPLLSTAT_LOCK ) == 0UL )
+	{
+	}
+
+	PLLCON = lowpowerPLLCON_ENABLE | lowpowerPLLCON_CONNECT;
+	PLLFEED = 0xAA;
+	PLLFEED = 0x55;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
@@ -64,6 +64,8 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "lowpower.h"
+#include "strfmt.h"
 
 
 /*-----------------------------------------------------------*/
@@ -74,6 +76,16 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Stack of each task, in words. */
+#define mainTASK_STACK_SIZE	( 90 )
+
+/* How often the tickless idle figures are reported on UART1, see 
+lowPowerReport() below. */
+#define mainLOW_POWER_REPORT_PERIOD	( ( TickType_t ) 10000 / portTICK_PERIOD_MS )
+
+/* The 30 characters of the labels and line end, four numbers and the NUL. */
+#define mainLOW_POWER_REPORT_LENGTH	( 30 + ( 4 * strfmtMAX_DIGITS ) + 1 )
+
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -87,7 +99,7 @@ static void prvSetupHardware( void );
 void ledToggle1000ms( void * pvParameters )
 {
     /* The parameter value is expected to be 1 as 1 is passed in the
-    pvParameters value in the call to xTaskCreate() below. */
+    pvParameters value in the call to xTaskCreateStatic() below. */
     configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 
     for( ;; )
@@ -112,8 +124,73 @@ void ledToggle1000ms( void * pvParameters )
 	TaskHandle_t ledToggle1000Handler = NULL;
 
 	
-	// Task creation return status
-	BaseType_t xReturned;
+	// Its stack and control block
+	static StackType_t ledToggle1000Stack[mainTASK_STACK_SIZE];
+	static StaticTask_t ledToggle1000TCB;
+
+/* UART1, from prvSetupHardware(). */
+static xComPortHandle serialPort = NULL;
+
+#if( configUSE_TICKLESS_IDLE == 2 )
+
+/* Kept off the task's stack, which is only mainTASK_STACK_SIZE words. */
+static xLowPowerStats lowPowerPrevious, lowPowerCurrent;
+static char lowPowerReportLine[ mainLOW_POWER_REPORT_LENGTH ];
+
+static StackType_t lowPowerReportStack[mainTASK_STACK_SIZE];
+static StaticTask_t lowPowerReportTCB;
+
+/* Writes a line like
+
+	sleeps=98 pd=0 asleep=9790 wakes/s=30
+
+to UART1 every mainLOW_POWER_REPORT_PERIOD, from vLowPowerGetStats().  The 
+processor woke once for each sleep and once for each tick it did not sleep 
+through, so wakes/s is what tickless idle brings configTICK_RATE_HZ down to.
+The report's own wake and its UART1 interrupts are counted in it.  This task 
+always waits with a timeout, so the processor never powers down and no time
+goes uncounted. */
+void lowPowerReport( void * pvParameters )
+{
+TickType_t xLastWakeTime;
+unsigned long ulSleeps, ulTicksAsleep, ulWakes;
+char *pcNext;
+
+	( void ) pvParameters;
+
+	vLowPowerGetStats( &lowPowerPrevious );
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, mainLOW_POWER_REPORT_PERIOD );
+		vLowPowerGetStats( &lowPowerCurrent );
+
+		ulSleeps = lowPowerCurrent.ulSleeps - lowPowerPrevious.ulSleeps;
+		ulTicksAsleep = lowPowerCurrent.ulTicksAsleep - lowPowerPrevious.ulTicksAsleep;
+		ulWakes = ulSleeps + ( ( unsigned long ) mainLOW_POWER_REPORT_PERIOD - ulTicksAsleep );
+
+		pcNext = pcStrFmtAppendString( lowPowerReportLine, "sleeps=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulSleeps );
+		pcNext = pcStrFmtAppendString( pcNext, " pd=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, lowPowerCurrent.ulPowerDowns - lowPowerPrevious.ulPowerDowns );
+		pcNext = pcStrFmtAppendString( pcNext, " asleep=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulTicksAsleep );
+		pcNext = pcStrFmtAppendString( pcNext, " wakes/s=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ( ulWakes * configTICK_RATE_HZ ) / ( unsigned long ) mainLOW_POWER_REPORT_PERIOD );
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+		configASSERT( ( unsigned long ) ( pcNext - lowPowerReportLine ) < mainLOW_POWER_REPORT_LENGTH );
+
+		lowPowerPrevious = lowPowerCurrent;
+
+		/* Wait for space rather than lose the line, but never for longer 
+		than a period. */
+		xSerialWrite( serialPort, ( signed char * ) lowPowerReportLine, ( unsigned long ) ( pcNext - lowPowerReportLine ), mainLOW_POWER_REPORT_PERIOD );
+	}
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*
  * Application entry point:
  * Starts all the other tasks, then starts the scheduler. 
@@ -125,13 +202,18 @@ int main( void )
 
 
     /* Create Tasks here */
-    xReturned = xTaskCreate(
+    ledToggle1000Handler = xTaskCreateStatic(
                     ledToggle1000ms,       /* Function that implements the task. */
                     "LED Toggle 1000 ms",          /* Text name for the task. */
-                    90,      /* Stack size in words, not bytes. */
+                    mainTASK_STACK_SIZE,      /* Stack size in words, not bytes. */
                     ( void * ) 1,    /* Parameter passed into the task. */
                     1,/* Priority at which the task is created. */
-                    &ledToggle1000Handler );      /* Used to pass out the created task's handle. */
+                    ledToggle1000Stack,      /* Array to use as the task's stack. */
+                    &ledToggle1000TCB );      /* Variable to hold the task's data structure. */
+
+#if( configUSE_TICKLESS_IDLE == 2 )
+	xTaskCreateStatic( lowPowerReport, "LowPower", mainTASK_STACK_SIZE, NULL, 1, lowPowerReportStack, &lowPowerReportTCB );
+#endif
 
 	
 
@@ -145,8 +227,8 @@ int main( void )
 	these demo application projects then ensure Supervisor mode is used here. */
 	vTaskStartScheduler();
 
-	/* Should never reach here!  If you do then there was not enough heap
-	available for the idle task to be created. */
+	/* Should never reach here!  The idle task is created from static memory,
+	see staticmem.c, so the scheduler cannot fail to start for want of heap. */
 	for( ;; );
 }
 /*-----------------------------------------------------------*/
@@ -157,7 +239,7 @@ static void prvSetupHardware( void )
 	setup is managed by the settings in the project file. */
 
 	/* Configure UART */
-	xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
+	serialPort = xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
 
 	/* Configure GPIO */
 	GPIO_init();
@@ -0,0 +1,288 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * A pvPortMalloc() and vPortFree() of fixed size blocks, see poolheap.h.
+ *
+ * All the classes' blocks are carved out of one array the first time 
+ * pvPortMalloc() is called, class after class, and threaded on a free list 
+ * per class.  A block is found a class by its address, so nothing is stored
+ * in front of it.  The only loops run over the classes, of which there are
+ * three, so the cost of a call does not depend on the state of the pools.  
+ * Unlike heap_2.c a block of one class is never split to serve a smaller 
+ * request, so the pools do not fragment, at the price of the space a request
+ * leaves unused in its block.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "poolheap.h"
+
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( poolheapENABLE == 1 ) )
+
+/* X( pcName, xBlockSize, uxBlocks ) for each class.  The kernel allocates a 
+task's TCB and stack separately, and a queue's structure and storage
+together. */
+#define poolheapCLASSES( X )																						\
+	X( "TCB",	sizeof( StaticTask_t ),											poolheapTCB_BLOCKS )				\
+	X( "Stack",	( ( size_t ) configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ),	poolheapSTACK_BLOCKS )			\
+	X( "Queue",	( sizeof( StaticQueue_t ) + poolheapQUEUE_STORAGE_BYTES ),		poolheapQUEUE_BLOCKS )
+
+/* Every block keeps the port's alignment. */
+#define poolheapROUND_UP( xSize )	( ( ( size_t ) ( xSize ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+#define poolheapCLASS_INIT( pcName, xSize, uxBlocks )	{ pcName, poolheapROUND_UP( xSize ), ( uxBlocks ), NULL, NULL, NULL, 0, 0, 0UL },
+#define poolheapCLASS_BYTES( pcName, xSize, uxBlocks )	+ ( poolheapROUND_UP( xSize ) * ( uxBlocks ) )
+#define poolheapCLASS_COUNT( pcName, xSize, uxBlocks )	+ 1
+
+#define poolheapNUM_CLASSES			( 0 poolheapCLASSES( poolheapCLASS_COUNT ) )
+#define poolheapTOTAL_BYTES			( ( size_t ) ( 0 poolheapCLASSES( poolheapCLASS_BYTES ) ) )
+
+/* A free block holds the link to the next free block of its class. */
+typedef struct POOL_BLOCK
+{
+	struct POOL_BLOCK *pxNext;
+} xPoolBlock;
+
+typedef struct POOL_CLASS
+{
+	const char *pcName;
+	size_t xBlockSize;
+	unsigned portBASE_TYPE uxBlocks;
+	uint8_t *pucStart;					/* The class's blocks are from here... */
+	uint8_t *pucEnd;					/* ...up to here. */
+	xPoolBlock *pxFree;
+	unsigned portBASE_TYPE uxUsed;
+	unsigned portBASE_TYPE uxPeak;
+	unsigned long ulExhausted;
+} xPoolClass;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Carve ucPoolHeap into the classes' blocks and put them all on the free
+ * lists.  Called with the scheduler suspended.
+ */
+static void prvPoolInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* Room for the blocks, and to align the first of them. */
+static uint8_t ucPoolHeap[ poolheapTOTAL_BYTES + portBYTE_ALIGNMENT ];
+
+static xPoolClass xClasses[ poolheapNUM_CLASSES ] =
+{
+	poolheapCLASSES( poolheapCLASS_INIT )
+};
+
+static BaseType_t xPoolHasBeenInitialised = pdFALSE;
+static size_t xFreeBytesRemaining = poolheapTOTAL_BYTES;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xPoolClass *pxFit = NULL, *pxTake = NULL;
+xPoolBlock *pxBlock;
+void *pvReturn = NULL;
+unsigned portBASE_TYPE ux;
+
+	vTaskSuspendAll();
+	{
+		if( xPoolHasBeenInitialised == pdFALSE )
+		{
+			prvPoolInit();
+			xPoolHasBeenInitialised = pdTRUE;
+		}
+
+		if( xWantedSize > ( size_t ) 0 )
+		{
+			/* The smallest class the request fits, and the smallest it fits
+			that has a block free. */
+			for( ux = 0; ux < poolheapNUM_CLASSES; ux++ )
+			{
+				if( xClasses[ ux ].xBlockSize >= xWantedSize )
+				{
+					if( ( pxFit == NULL ) || ( xClasses[ ux ].xBlockSize < pxFit->xBlockSize ) )
+					{
+						pxFit = &( xClasses[ ux ] );
+					}
+
+					if( ( xClasses[ ux ].pxFree != NULL ) && ( ( pxTake == NULL ) || ( xClasses[ ux ].xBlockSize < pxTake->xBlockSize ) ) )
+					{
+						pxTake = &( xClasses[ ux ] );
+					}
+				}
+			}
+
+			if( ( pxFit != NULL ) && ( pxFit->pxFree == NULL ) )
+			{
+				pxFit->ulExhausted++;
+			}
+
+			if( pxTake != NULL )
+			{
+				pxBlock = pxTake->pxFree;
+				pxTake->pxFree = pxBlock->pxNext;
+				pxTake->uxUsed++;
+
+				if( pxTake->uxUsed > pxTake->uxPeak )
+				{
+					pxTake->uxPeak = pxTake->uxUsed;
+				}
+
+				xFreeBytesRemaining -= pxTake->xBlockSize;
+				pvReturn = ( void * ) pxBlock;
+			}
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+xPoolClass *pxClass = NULL;
+xPoolBlock *pxBlock = ( xPoolBlock * ) pv;
+unsigned portBASE_TYPE ux;
+
+	if( pv != NULL )
+	{
+		for( ux = 0; ux < poolheapNUM_CLASSES; ux++ )
+		{
+			if( ( ( uint8_t * ) pv >= xClasses[ ux ].pucStart ) && ( ( uint8_t * ) pv < xClasses[ ux ].pucEnd ) )
+			{
+				pxClass = &( xClasses[ ux ] );
+				break;
+			}
+		}
+
+		/* Not a block of this heap, or not the start of one. */
+		configASSERT( pxClass != NULL );
+		configASSERT( ( ( size_t ) ( ( uint8_t * ) pv - pxClass->pucStart ) % pxClass->xBlockSize ) == ( size_t ) 0 );
+
+		if( pxClass != NULL )
+		{
+			vTaskSuspendAll();
+			{
+				pxBlock->pxNext = pxClass->pxFree;
+				pxClass->pxFree = pxBlock;
+				pxClass->uxUsed--;
+				xFreeBytesRemaining += pxClass->xBlockSize;
+				traceFREE( pv, pxClass->xBlockSize );
+			}
+			( void ) xTaskResumeAll();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet, as in heap_2.c. */
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPoolClasses( void )
+{
+	return ( unsigned portBASE_TYPE ) poolheapNUM_CLASSES;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolGetStats( unsigned portBASE_TYPE uxClass, xPoolStats *pxStats )
+{
+xPoolClass *pxClass;
+
+	configASSERT( uxClass < poolheapNUM_CLASSES );
+	pxClass = &( xClasses[ uxClass ] );
+
+	vTaskSuspendAll();
+	{
+		pxStats->pcName = pxClass->pcName;
+		pxStats->xBlockSize = pxClass->xBlockSize;
+		pxStats->uxBlocks = pxClass->uxBlocks;
+		pxStats->uxUsed = pxClass->uxUsed;
+		pxStats->uxPeak = pxClass->uxPeak;
+		pxStats->ulExhausted = pxClass->ulExhausted;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPoolInit( void )
+{
+uint8_t *pucNext;
+xPoolBlock *pxBlock;
+unsigned portBASE_TYPE ux, uxBlock;
+
+	pucNext = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) &ucPoolHeap[ portBYTE_ALIGNMENT ] ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+
+	for( ux = 0; ux < poolheapNUM_CLASSES; ux++ )
+	{
+		xClasses[ ux ].pucStart = pucNext;
+		xClasses[ ux ].pxFree = NULL;
+
+		/* Threaded from the top down, so the lowest block is handed out 
+		first. */
+		pucNext += xClasses[ ux ].xBlockSize * xClasses[ ux ].uxBlocks;
+		xClasses[ ux ].pucEnd = pucNext;
+
+		for( uxBlock = xClasses[ ux ].uxBlocks; uxBlock > 0; uxBlock-- )
+		{
+			pxBlock = ( xPoolBlock * ) ( xClasses[ ux ].pucStart + ( ( uxBlock - 1 ) * xClasses[ ux ].xBlockSize ) );
+			pxBlock->pxNext = xClasses[ ux ].pxFree;
+			xClasses[ ux ].pxFree = pxBlock;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
@@ -0,0 +1,224 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Single edge PWM outputs, used to blink LEDs without waking the processor.
+ *
+ * The PWM counter is prescaled to count ticks and reset by MR0, which so 
+ * sets the period of every channel.  Channel n goes high as the count resets
+ * and low when it reaches MRn.  New match values are latched through LER and
+ * take effect at the start of the next period, so a change never leaves a
+ * runt pulse.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "GPIO.h"
+#include "GPIO_cfg.h"
+#include "pwm.h"
+
+#define pwmBASE						( ( unsigned long ) 0xE0014000 )
+
+/* Register offsets.  MR4 to MR6 are not after MR3. */
+#define pwmIR						( ( unsigned long ) 0x00 )
+#define pwmTCR						( ( unsigned long ) 0x04 )
+#define pwmPR						( ( unsigned long ) 0x0C )
+#define pwmMCR						( ( unsigned long ) 0x14 )
+#define pwmMR0						( ( unsigned long ) 0x18 )
+#define pwmPCR						( ( unsigned long ) 0x4C )
+#define pwmLER						( ( unsigned long ) 0x50 )
+
+#define pwmTCR_COUNTER_ENABLE		( ( unsigned long ) 0x01 )
+#define pwmTCR_COUNTER_RESET		( ( unsigned long ) 0x02 )
+#define pwmTCR_PWM_ENABLE			( ( unsigned long ) 0x08 )
+#define pwmMCR_MR0_RESET			( ( unsigned long ) 0x02 )
+#define pwmPCR_ENABLE( ulChannel )	( ( unsigned long ) 0x100 << ( ulChannel ) )
+#define pwmLER_LATCH( ulChannel )	( ( unsigned long ) 0x01 << ( ulChannel ) )
+
+/* One count per tick. */
+#define pwmPRESCALE					( ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL )
+
+/* Register access.  The host build supplies its own, see serial.c. */
+#ifndef pwmREAD
+	#define pwmREAD( ulOffset )				( *( ( volatile unsigned long * ) ( pwmBASE + ( ulOffset ) ) ) )
+	#define pwmWRITE( ulOffset, ulValue )	( pwmREAD( ulOffset ) = ( ulValue ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* A pin with a PWM output and its PINSEL1 field. */
+typedef struct PWM_CHANNEL
+{
+	portX_t ePort;
+	pinX_t ePin;
+	unsigned long ulChannel;
+	unsigned long ulMatchOffset;
+	unsigned long ulFunction;
+} xPWMChannel;
+
+/* PWM5 on P0.21 is the only output on a pin the GPIO layer addresses, as 
+pinX_t and GPIO_Config only cover P0.16 to P0.31.  The others are all below 
+that: PWM1, PWM3, PWM4 and PWM6 are on P0.0, P0.1, P0.8 and P0.9, which the 
+UARTs use, and PWM2 is on P0.7, which is also SSEL0 and EINT2. */
+static const xPWMChannel xChannels[] =
+{
+	{ PORT_0, PIN5, 5UL, 0x44UL, ( unsigned long ) PIN_FUNC_ALT1 }
+};
+
+#define pwmNUM_CHANNELS				( sizeof( xChannels ) / sizeof( xChannels[ 0 ] ) )
+
+/* Bit n set while channel n drives its pin. */
+static unsigned long ulChannelsRunning = 0;
+static TickType_t xRunningPeriod = 0;
+
+static const xPWMChannel *prvFindChannel( portX_t ePort, pinX_t ePin );
+static void prvSetFunction( const xPWMChannel *pxChannel, unsigned long ulFunction );
+
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xPWMStart( portX_t ePort, pinX_t ePin, TickType_t xPeriod, TickType_t xOnTicks )
+{
+const xPWMChannel *pxChannel = prvFindChannel( ePort, ePin );
+unsigned long ulBit;
+signed portBASE_TYPE xReturn = pdFAIL;
+
+	/* A pin that is always high or always low is left to GPIO. */
+	if( ( pxChannel == NULL ) || ( xOnTicks == 0 ) || ( xOnTicks >= xPeriod ) )
+	{
+		return pdFAIL;
+	}
+
+	ulBit = 1UL << pxChannel->ulChannel;
+
+	portENTER_CRITICAL();
+	{
+		if( ( ulChannelsRunning & ~ulBit ) == 0UL )
+		{
+			if( ulChannelsRunning == 0UL )
+			{
+				/* Start from a clean count. */
+				pwmWRITE( pwmTCR, pwmTCR_COUNTER_RESET );
+				pwmWRITE( pwmPR, pwmPRESCALE );
+				pwmWRITE( pwmMCR, pwmMCR_MR0_RESET );
+				pwmWRITE( pwmIR, 0xFFUL );
+			}
+
+			/* Nothing else depends on the period, so it can change. */
+			pwmWRITE( pwmMR0, ( unsigned long ) xPeriod );
+			xRunningPeriod = xPeriod;
+			xReturn = pdPASS;
+		}
+		else if( xPeriod == xRunningPeriod )
+		{
+			xReturn = pdPASS;
+		}
+
+		if( xReturn == pdPASS )
+		{
+			pwmWRITE( pxChannel->ulMatchOffset, ( unsigned long ) xOnTicks );
+			pwmWRITE( pwmLER, pwmLER_LATCH( 0UL ) | pwmLER_LATCH( pxChannel->ulChannel ) );
+
+			if( ( ulChannelsRunning & ulBit ) == 0UL )
+			{
+				pwmWRITE( pwmPCR, pwmREAD( pwmPCR ) | pwmPCR_ENABLE( pxChannel->ulChannel ) );
+				prvSetFunction( pxChannel, pxChannel->ulFunction );
+
+				if( ulChannelsRunning == 0UL )
+				{
+					pwmWRITE( pwmTCR, pwmTCR_COUNTER_ENABLE | pwmTCR_PWM_ENABLE );
+				}
+
+				ulChannelsRunning |= ulBit;
+			}
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPWMStop( portX_t ePort, pinX_t ePin )
+{
+const xPWMChannel *pxChannel = prvFindChannel( ePort, ePin );
+unsigned long ulBit;
+
+	if( pxChannel == NULL )
+	{
+		return;
+	}
+
+	ulBit = 1UL << pxChannel->ulChannel;
+
+	portENTER_CRITICAL();
+	{
+		if( ( ulChannelsRunning & ulBit ) != 0UL )
+		{
+			prvSetFunction( pxChannel, ( unsigned long ) PIN_FUNC_GPIO );
+			pwmWRITE( pwmPCR, pwmREAD( pwmPCR ) & ~pwmPCR_ENABLE( pxChannel->ulChannel ) );
+			ulChannelsRunning &= ~ulBit;
+
+			/* The counter only runs while something uses it. */
+			if( ulChannelsRunning == 0UL )
+			{
+				pwmWRITE( pwmTCR, 0UL );
+			}
+		}
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static const xPWMChannel *prvFindChannel( portX_t ePort, pinX_t ePin )
+{
+unsigned portBASE_TYPE ux;
+
+	for( ux = 0; ux < pwmNUM_CHANNELS; ux++ )
+	{
+		if( ( xChannels[ ux ].ePort == ePort ) && ( xChannels[ ux ].ePin == ePin ) )
+		{
+			return &xChannels[ ux ];
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetFunction( const xPWMChannel *pxChannel, unsigned long ulFunction )
+{
+unsigned long ulShift = ( ( unsigned long ) pxChannel->ePin - ( unsigned long ) PIN0 ) * 2UL;
+
+	/* Called in a critical section, PINSEL1 is shared with GPIO_init() and
+	the other drivers. */
+	PINSEL1 = ( PINSEL1 & ~( 0x03UL << ulShift ) ) | ( ulFunction << ulShift );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,205 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Periodic dump of the kernel's per task run-time statistics.
+ *
+ * vStartRunTimeStatsTask() creates a single task that wakes every xPeriod 
+ * ticks, takes a snapshot with uxTaskGetSystemState() and writes a short 
+ * table to the report port, for example:
+ *
+ *     cpu us=1000014 idle=71
+ *      IDLE 71 6430117
+ *      LED Toggle 28 2571544
+ *      SerStat 0 912
+ *
+ * The first line gives the microseconds covered and the idle task's share of
+ * them as a percentage.  Each task then gets a line with its share of the 
+ * period and its total run time in microseconds since the scheduler started,
+ * which wraps after a little over 71 minutes.  Shares are rounded down, so 
+ * they need not add up to 100.  A task created during the period is measured
+ * from when it was created.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "strfmt.h"
+#include "runstats.h"
+
+#define runstatsSTACK_SIZE			configMINIMAL_STACK_SIZE
+#define runstatsMAX_TASKS			( 12 )
+#define runstatsLINE_LENGTH			( configMAX_TASK_NAME_LEN + 32 )
+
+/*-----------------------------------------------------------*/
+
+static void vRunTimeStatsTask( void *pvParameters );
+
+/*
+ * The run time a task had at the previous report, 0 if it was not there.  Run
+ * times are kept as the kernel's uint32_t, so differences wrap as it does.
+ */
+static uint32_t prvPreviousRunTime( TaskHandle_t xHandle );
+
+/*-----------------------------------------------------------*/
+
+static xComPortHandle xReportPort = NULL;
+static SemaphoreHandle_t xReportMutex = NULL;
+static TickType_t xReportPeriod;
+
+/* Kept off the task's stack, which is only the minimal size. */
+static TaskStatus_t xStatus[ runstatsMAX_TASKS ];
+static TaskHandle_t xPreviousHandles[ runstatsMAX_TASKS ];
+static uint32_t ulPreviousRunTimes[ runstatsMAX_TASKS ];
+static unsigned portBASE_TYPE uxPreviousTasks = 0;
+static char cLine[ runstatsLINE_LENGTH ];
+
+/* The task's own stack and TCB. */
+static StackType_t xRunStatsStack[ runstatsSTACK_SIZE ];
+static StaticTask_t xRunStatsTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartRunTimeStatsTask( xComPortHandle pxReportPort, SemaphoreHandle_t xPortMutex, unsigned portBASE_TYPE uxPriority, TickType_t xPeriod )
+{
+	xReportPort = pxReportPort;
+	xReportMutex = xPortMutex;
+	xReportPeriod = xPeriod;
+
+	xTaskCreateStatic( vRunTimeStatsTask, "RunStat", runstatsSTACK_SIZE, NULL, uxPriority, xRunStatsStack, &xRunStatsTCB );
+}
+/*-----------------------------------------------------------*/
+
+static void vRunTimeStatsTask( void *pvParameters )
+{
+TickType_t xLastWakeTime;
+uint32_t ulTotal, ulPreviousTotal = 0UL, ulPeriod, ulRunTime;
+unsigned long ulPercentDivisor;
+unsigned portBASE_TYPE uxTasks, ux;
+TaskHandle_t xIdleHandle;
+char *pcNext;
+
+	( void ) pvParameters;
+
+	xIdleHandle = xTaskGetIdleTaskHandle();
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xReportPeriod );
+
+		/* Returns 0, and fills in nothing, if there are more tasks than 
+		room for them. */
+		uxTasks = uxTaskGetSystemState( xStatus, runstatsMAX_TASKS, &ulTotal );
+		configASSERT( uxTasks != 0 );
+
+		ulPeriod = ulTotal - ulPreviousTotal;
+		ulPreviousTotal = ulTotal;
+
+		/* A share is run time over the period, divided this way round to 
+		keep the arithmetic within 32 bits. */
+		ulPercentDivisor = ulPeriod / 100UL;
+		if( ulPercentDivisor == 0UL )
+		{
+			ulPercentDivisor = 1UL;
+		}
+
+		pcNext = pcStrFmtAppendString( cLine, "cpu us=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulPeriod );
+		pcNext = pcStrFmtAppendString( pcNext, " idle=" );
+
+		for( ux = 0; ux < uxTasks; ux++ )
+		{
+			if( xStatus[ ux ].xHandle == xIdleHandle )
+			{
+				pcNext = pcStrFmtAppendNumber( pcNext, ( xStatus[ ux ].ulRunTimeCounter - prvPreviousRunTime( xIdleHandle ) ) / ulPercentDivisor );
+				break;
+			}
+		}
+
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+
+		/* The table goes out in one piece, whoever else shares the port. */
+		if( xReportMutex != NULL )
+		{
+			xSemaphoreTake( xReportMutex, portMAX_DELAY );
+		}
+
+		xSerialWrite( xReportPort, ( signed char * ) cLine, ( unsigned long ) ( pcNext - cLine ), xReportPeriod );
+
+		for( ux = 0; ux < uxTasks; ux++ )
+		{
+			ulRunTime = xStatus[ ux ].ulRunTimeCounter;
+
+			pcNext = pcStrFmtAppendString( cLine, " " );
+			pcNext = pcStrFmtAppendString( pcNext, xStatus[ ux ].pcTaskName );
+			pcNext = pcStrFmtAppendString( pcNext, " " );
+			pcNext = pcStrFmtAppendNumber( pcNext, ( ulRunTime - prvPreviousRunTime( xStatus[ ux ].xHandle ) ) / ulPercentDivisor );
+			pcNext = pcStrFmtAppendString( pcNext, " " );
+			pcNext = pcStrFmtAppendNumber( pcNext, ulRunTime );
+			pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+
+			/* Wait for space rather than lose the line, but never for 
+			longer than a period. */
+			xSerialWrite( xReportPort, ( signed char * ) cLine, ( unsigned long ) ( pcNext - cLine ), xReportPeriod );
+		}
+
+		if( xReportMutex != NULL )
+		{
+			xSemaphoreGive( xReportMutex );
+		}
+
+		for( ux = 0; ux < uxTasks; ux++ )
+		{
+			xPreviousHandles[ ux ] = xStatus[ ux ].xHandle;
+			ulPreviousRunTimes[ ux ] = xStatus[ ux ].ulRunTimeCounter;
+		}
+
+		uxPreviousTasks = uxTasks;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPreviousRunTime( TaskHandle_t xHandle )
+{
+unsigned portBASE_TYPE ux;
+
+	for( ux = 0; ux < uxPreviousTasks; ux++ )
+	{
+		if( xPreviousHandles[ ux ] == xHandle )
+		{
+			return ulPreviousRunTimes[ ux ];
+		}
+	}
+
+	return 0UL;
+}
+/*-----------------------------------------------------------*/
@@ -26,15 +26,47 @@
  */
 
 
-/* 
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0. 
 
-	Note this driver is used to test the FreeRTOS port.  It is NOT intended to
-	be an example of an efficient implementation!
+/* 
+	INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0 AND UART1.
+
+	Each port is described by an entry in xPorts[], which holds the address 
+	of its register block, its VIC channel and slot, its Rx and Tx rings and
+	its statistics.  serCOM1 is UART0 and serCOM2 is UART1.  Both ports can
+	be used at the same time, each has its own entry point in serialISR.s.
+
+	Characters are passed between the tasks and the ISR through single 
+	producer/single consumer rings, so the tasks that share a port must 
+	serialise their writes.  Each THRE interrupt refills the Tx FIFO and
+	each Rx interrupt drains the Rx FIFO.  Characters that arrive while the
+	Rx ring is full are counted in ulRxDropped, and ulRxHighWater records 
+	the fullest the Rx ring has been, so serRX_BUFFER_SIZE can be sized from
+	a running system.  Reading the LSR clears its error bits, so every read
+	of it goes through prvCountLineErrors().
+
+	The divisor for each eBaud rate is worked out at build time, rounded to 
+	the nearest value.  A rate marked as required in serBAUD_TABLE whose 
+	divisor is further than serMAX_BAUD_ERROR from the wanted rate stops the
+	build; any other such rate is rejected when the port is opened.  
+	xSerialSetBaud() changes the rate of an open port and leaves its rings
+	and pending descriptors alone.
+
+	Larger transmissions can be submitted as chains of descriptors with 
+	xSerialSubmit().  The ISR streams them straight from the caller's memory 
+	without copying.  Pending descriptors are sent before anything in the Tx
+	ring, so the two paths are not ordered with respect to each other.
+
+	xSerialRead() and xSerialWrite() block the calling task on its direct to
+	task notification.  The task records its handle in the port before it 
+	blocks and the ISR notifies it once enough characters have arrived, or 
+	enough space has been freed, then yields straight to it if it has the 
+	higher priority.  One task at a time can block on each direction of a 
+	port.
 */
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
@@ -47,23 +79,119 @@
 /*-----------------------------------------------------------*/
 
 /* Constants to setup I/O */
-#define mainTX_ENABLE		( ( unsigned long ) 0x00010000 )	/* UART1. */
-#define mainRX_ENABLE		( ( unsigned long ) 0x00040000 ) 	/* UART1. */
+#define serUART0_PINSEL					( ( unsigned long ) 0x00000005 )	/* TxD0 and RxD0 on P0.0 and P0.1. */
+#define serUART1_PINSEL					( ( unsigned long ) 0x00050000 )	/* TxD1 and RxD1 on P0.8 and P0.9. */
+
+/* Addresses of the UART register blocks, and the offset of each register
+within a block. */
+#define serUART0_BASE					( ( unsigned long ) 0xE000C000 )
+#define serUART1_BASE					( ( unsigned long ) 0xE0010000 )
+
+#define serRBR							( 0x00 )
+#define serTHR							( 0x00 )
+#define serDLL							( 0x00 )
+#define serIER							( 0x04 )
+#define serDLM							( 0x04 )
+#define serIIR							( 0x08 )
+#define serFCR							( 0x08 )
+#define serLCR							( 0x0C )
+#define serLSR							( 0x14 )
+
+/* Register accessors.  The host build in ../host supplies its own so the
+registers can be simulated. */
+#ifndef serREAD
+	#define serREAD( pxPort, ulOffset )				( *( ( volatile unsigned char * ) ( ( pxPort )->ulBase + ( ulOffset ) ) ) )
+	#define serWRITE( pxPort, ulOffset, ucValue )	( serREAD( pxPort, ulOffset ) = ( unsigned char ) ( ucValue ) )
+#endif
 
 /* Constants to setup and access the UART. */
 #define serDLAB							( ( unsigned char ) 0x80 )
 #define serENABLE_INTERRUPTS			( ( unsigned char ) 0x03 )
-#define serNO_PARITY					( ( unsigned char ) 0x00 )
-#define ser1_STOP_BIT					( ( unsigned char ) 0x00 )
-#define ser8_BIT_CHARS					( ( unsigned char ) 0x03 )
+#define serTHRE_INTERRUPT				( ( unsigned char ) 0x02 )
+#define serPARITY_ENABLE				( ( unsigned char ) 0x08 )
+#define serPARITY_SHIFT					( 4 )
+#define serSTOP_BITS_SHIFT				( 2 )
 #define serFIFO_ON						( ( unsigned char ) 0x01 )
 #define serCLEAR_FIFO					( ( unsigned char ) 0x06 )
 #define serWANTED_CLOCK_SCALING			( ( unsigned long ) 16 )
-
-/* Constants to setup and access the VIC. */
+#define serDATA_READY					( ( unsigned char ) 0x01 )
+#define serOVERRUN_ERROR				( ( unsigned char ) 0x02 )
+#define serPARITY_ERROR					( ( unsigned char ) 0x04 )
+#define serFRAMING_ERROR				( ( unsigned char ) 0x08 )
+#define serBREAK_INTERRUPT				( ( unsigned char ) 0x10 )
+#define serLINE_ERRORS					( serOVERRUN_ERROR | serPARITY_ERROR | serFRAMING_ERROR | serBREAK_INTERRUPT )
+#define serTX_EMPTY						( ( unsigned char ) 0x40 )
+#define serTX_FIFO_LENGTH				( 16 )
+#define serRX_TRIGGER_SHIFT				( 6 )
+
+/* The largest error, in tenths of a percent, allowed between a wanted baud
+rate and the rate its divisor actually gives. */
+#ifndef serMAX_BAUD_ERROR
+	#define serMAX_BAUD_ERROR			( 20UL )
+#endif
+
+/* The divisor for a baud rate rounded to nearest, its error scaled by the 
+CPU clock, and whether it fits the 16 bit divisor within the error budget. */
+#define serDIVISOR( ulBaud )			( ( configCPU_CLOCK_HZ + ( ( ulBaud ) * ( serWANTED_CLOCK_SCALING / 2UL ) ) ) / ( ( ulBaud ) * serWANTED_CLOCK_SCALING ) )
+#define serACTUAL_CLOCK( ulBaud )		( serDIVISOR( ulBaud ) * ( ulBaud ) * serWANTED_CLOCK_SCALING )
+#define serCLOCK_ERROR( ulBaud )		( ( serACTUAL_CLOCK( ulBaud ) > configCPU_CLOCK_HZ ) ? ( serACTUAL_CLOCK( ulBaud ) - configCPU_CLOCK_HZ ) : ( configCPU_CLOCK_HZ - serACTUAL_CLOCK( ulBaud ) ) )
+#define serBAUD_IN_BUDGET( ulBaud )		( ( serDIVISOR( ulBaud ) != 0UL ) && ( serDIVISOR( ulBaud ) <= 0xffffUL ) && ( serCLOCK_ERROR( ulBaud ) <= ( ( configCPU_CLOCK_HZ / 1000UL ) * serMAX_BAUD_ERROR ) ) )
+
+/* One row per eBaud entry, in the same order.  The last column says whether
+the build must fail if the rate cannot be generated from configCPU_CLOCK_HZ.
+At 60MHz 50 baud needs a divisor larger than 16 bits. */
+#define serBAUD_TABLE( X )					\
+	X( ser50,		50UL,		pdFALSE )	\
+	X( ser75,		75UL,		pdFALSE )	\
+	X( ser110,		110UL,		pdFALSE )	\
+	X( ser134,		134UL,		pdFALSE )	\
+	X( ser150,		150UL,		pdFALSE )	\
+	X( ser200,		200UL,		pdFALSE )	\
+	X( ser300,		300UL,		pdFALSE )	\
+	X( ser600,		600UL,		pdFALSE )	\
+	X( ser1200,		1200UL,		pdFALSE )	\
+	X( ser1800,		1800UL,		pdFALSE )	\
+	X( ser2400,		2400UL,		pdFALSE )	\
+	X( ser4800,		4800UL,		pdFALSE )	\
+	X( ser9600,		9600UL,		pdTRUE )	\
+	X( ser19200,	19200UL,	pdTRUE )	\
+	X( ser38400,	38400UL,	pdTRUE )	\
+	X( ser57600,	57600UL,	pdTRUE )	\
+	X( ser115200,	115200UL,	pdTRUE )
+
+#define serRATE_ENTRY( eRate, ulBaud, xRequired )		( ulBaud ),
+#define serDIVISOR_ENTRY( eRate, ulBaud, xRequired )	( unsigned short ) ( serBAUD_IN_BUDGET( ulBaud ) ? serDIVISOR( ulBaud ) : 0UL ),
+#define serCHECK_ENTRY( eRate, ulBaud, xRequired )		typedef char eRate##_is_outside_serMAX_BAUD_ERROR[ ( ( ( xRequired ) == pdFALSE ) || serBAUD_IN_BUDGET( ulBaud ) ) ? 1 : -1 ];
+
+/* Line format used by xSerialPortInitMinimal(). */
+#define serMINIMAL_LINE_CONTROL			( ( unsigned char ) serBITS_8 )
+
+/* Rx trigger level used until vSerialSetRxTrigger() is called. */
+#ifndef serRX_TRIGGER_DEFAULT
+	#define serRX_TRIGGER_DEFAULT		serRX_TRIGGER_8
+#endif
+
+/* Sizes of the per port rings.  These must be powers of two so the free
+running indexes can be wrapped with a mask.  The Rx ring holds 11ms of 
+characters at 115200 baud. */
+#ifndef serRX_BUFFER_SIZE
+	#define serRX_BUFFER_SIZE			( 128 )
+#endif
+
+#ifndef serTX_BUFFER_SIZE
+	#define serTX_BUFFER_SIZE			( 64 )
+#endif
+
+#if ( ( serRX_BUFFER_SIZE & ( serRX_BUFFER_SIZE - 1 ) ) != 0 ) || ( ( serTX_BUFFER_SIZE & ( serTX_BUFFER_SIZE - 1 ) ) != 0 )
+	#error serRX_BUFFER_SIZE and serTX_BUFFER_SIZE must be powers of two.
+#endif
+
+/* Constants to setup and access the VIC.  The tick uses slot 0. */
+#define serU0VIC_CHANNEL				( ( unsigned long ) 0x0006 )
+#define serU0VIC_SLOT					( 2 )
 #define serU1VIC_CHANNEL				( ( unsigned long ) 0x0007 )
-#define serU1VIC_CHANNEL_BIT			( ( unsigned long ) 0x0080 )
-#define serU1VIC_ENABLE					( ( unsigned long ) 0x0020 )
+#define serU1VIC_SLOT					( 1 )
+#define serVIC_ENABLE					( ( unsigned long ) 0x0020 )
 
 /* Constant to access the VIC. */
 #define serCLEAR_VIC_INTERRUPT			( ( unsigned long ) 0 )
@@ -76,116 +204,741 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* Indexes into xPorts[]. */
+#define serUART0						( 0 )
+#define serUART1						( 1 )
+#define serNUM_PORTS					( 2 )
+
+/*-----------------------------------------------------------*/
+
+/* A single producer/single consumer ring.  uxHead is only written by the 
+producer and uxTail only by the consumer.  Both are free running and are
+wrapped with uxMask when the buffer is accessed. */
+typedef struct SERIAL_RING
+{
+	volatile unsigned portBASE_TYPE uxHead;
+	volatile unsigned portBASE_TYPE uxTail;
+	unsigned portBASE_TYPE uxMask;
+	unsigned char *pucBuffer;
+} xSerialRing;
+
+typedef struct SERIAL_PORT
+{
+	unsigned long ulBase;				/* Address of the UART register block. */
+	unsigned long ulPinSelect;			/* PINSEL0 bits that route the Tx and Rx pins to the UART. */
+	unsigned long ulVICChannel;
+	unsigned long ulVICSlot;
+	void ( *pvISREntry )( void );
+	xSerialRing xRxRing;
+	xSerialRing xTxRing;
+	volatile portBASE_TYPE xTHREEmpty;	/* pdTRUE when the transmitter has to be restarted by the task side. */
+	xSerialTxDescriptor * volatile pxTxHead;	/* Descriptor being sent, followed by those still pending. */
+	xSerialTxDescriptor *pxTxTail;
+	unsigned long ulTxOffset;			/* Next byte of pxTxHead to send. */
+	TaskHandle_t volatile xRxWaitingTask;	/* Task blocked in xSerialRead(), if any. */
+	volatile unsigned portBASE_TYPE uxRxWanted;	/* Characters that task is waiting for. */
+	TaskHandle_t volatile xTxWaitingTask;	/* Task blocked in xSerialWrite(), if any. */
+	xSerialStats xStats;
+} xSerialPort;
+
 /*-----------------------------------------------------------*/
-unsigned char receivedChar;
-unsigned char isNewCharAvailable = 0;
 
-unsigned char txBuffer[200];
-unsigned char txDataSizeToSend;
-unsigned char txDataSizeLeftToSend;
 /*
- * The asm wrapper for the interrupt service routine.
+ * The asm wrappers for the interrupt service routines.
  */
+extern void vUART0_ISREntry( void );
 extern void vUART_ISREntry( void );
 
 /* 
- * The C function called from the asm wrapper. 
+ * The C functions called from the asm wrappers. 
  */
+void vUART0_ISRHandler( void );
 void vUART_ISRHandler( void );
 
+/*
+ * The handler shared by both ports.
+ */
+static portBASE_TYPE prvUARTHandler( xSerialPort *pxPort );
+
+/*
+ * Program the line format, divisor, FIFOs and VIC slot of a port.
+ */
+static void prvSetupPort( xSerialPort *pxPort, unsigned long ulDivisor, unsigned char ucLineControl );
+
+/*
+ * Write the divisor latch of a port, leaving its line format as it was.
+ */
+static void prvSetDivisor( xSerialPort *pxPort, unsigned long ulDivisor );
+
+/*
+ * The divisor for any baud rate, or 0 if it cannot be generated within 
+ * serMAX_BAUD_ERROR.
+ */
+static unsigned long prvDivisorFor( unsigned long ulWantedBaud );
+
+/*
+ * Write as many characters from the pending descriptors, then the Tx ring, to
+ * the Tx FIFO as it will take, returning the number written.  Only called 
+ * when the Tx FIFO is empty.  *pxHigherPriorityTaskWoken is set if a 
+ * descriptor callback woke a task.
+ */
+static unsigned portBASE_TYPE prvFillTxFifo( xSerialPort *pxPort, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Add any error bits in ucStatus, a value read from the LSR, to the port's 
+ * counters.
+ */
+static void prvCountLineErrors( xSerialPort *pxPort, unsigned char ucStatus );
+
+/*
+ * Restart the transmitter if it has gone idle.
+ */
+static void prvKickTx( xSerialPort *pxPort );
+
+/*
+ * Write/read one character to/from a ring.  Return pdFALSE if the ring is
+ * full/empty.
+ */
+static portBASE_TYPE prvRingPut( xSerialRing *pxRing, unsigned char ucChar );
+static portBASE_TYPE prvRingGet( xSerialRing *pxRing, unsigned char *pucChar );
+
+/*
+ * Copy up to ulMaxLength characters out of a ring, returning the number 
+ * copied.
+ */
+static unsigned long prvRingRead( xSerialRing *pxRing, unsigned char *pucBuffer, unsigned long ulMaxLength );
+
+/*
+ * The number of characters waiting in a ring.
+ */
+#define prvRingCount( pxRing )			( ( pxRing )->uxHead - ( pxRing )->uxTail )
+
 /*-----------------------------------------------------------*/
 
-void xSerialPortInitMinimal( unsigned long ulWantedBaud)
+static unsigned char ucRxStorage[ serNUM_PORTS ][ serRX_BUFFER_SIZE ];
+static unsigned char ucTxStorage[ serNUM_PORTS ][ serTX_BUFFER_SIZE ];
+
+static xSerialPort xPorts[ serNUM_PORTS ] =
 {
-    unsigned long ulDivisor, ulWantedClock;
-	
-	/* Configure the UART1 pins.  All other pins remain at their default of 0. */
-	PINSEL0 |= mainTX_ENABLE;
-	PINSEL0 |= mainRX_ENABLE;
+	{
+		serUART0_BASE, serUART0_PINSEL, serU0VIC_CHANNEL, serU0VIC_SLOT, vUART0_ISREntry,
+		{ 0, 0, serRX_BUFFER_SIZE - 1, ucRxStorage[ serUART0 ] },
+		{ 0, 0, serTX_BUFFER_SIZE - 1, ucTxStorage[ serUART0 ] },
+		pdTRUE,
+		NULL, NULL, 0,
+		NULL, 0, NULL,
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{
+		serUART1_BASE, serUART1_PINSEL, serU1VIC_CHANNEL, serU1VIC_SLOT, vUART_ISREntry,
+		{ 0, 0, serRX_BUFFER_SIZE - 1, ucRxStorage[ serUART1 ] },
+		{ 0, 0, serTX_BUFFER_SIZE - 1, ucTxStorage[ serUART1 ] },
+		pdTRUE,
+		NULL, NULL, 0,
+		NULL, 0, NULL,
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	}
+};
+
+/* Baud rates and their divisors indexed by eBaud.  A divisor of 0 marks a
+rate that cannot be generated. */
+static const unsigned long ulBaudRates[] =
+{
+	serBAUD_TABLE( serRATE_ENTRY )
+};
+
+static const unsigned short usDivisors[] =
+{
+	serBAUD_TABLE( serDIVISOR_ENTRY )
+};
+
+/* Fail the build if a required rate is out of budget, or if the table and 
+eBaud have drifted apart. */
+serBAUD_TABLE( serCHECK_ENTRY )
+typedef char serBAUD_TABLE_does_not_match_eBaud[ ( ( sizeof( ulBaudRates ) / sizeof( ulBaudRates[ 0 ] ) ) == ( ser115200 + 1 ) ) ? 1 : -1 ];
+
+/*-----------------------------------------------------------*/
+
+xComPortHandle xSerialPortInit( eCOMPort ePort, eBaud eWantedBaud, eParity eWantedParity, eDataBits eWantedDataBits, eStopBits eWantedStopBits )
+{
+xSerialPort *pxPort;
+unsigned char ucLineControl;
+
+	if( ( ( unsigned portBASE_TYPE ) ePort >= serNUM_PORTS ) || ( eWantedBaud > ser115200 ) || ( usDivisors[ eWantedBaud ] == 0 ) )
+	{
+		return NULL;
+	}
+
+	pxPort = &xPorts[ ePort ];
+
+	ucLineControl = ( unsigned char ) eWantedDataBits;
+	ucLineControl |= ( unsigned char ) ( eWantedStopBits << serSTOP_BITS_SHIFT );
+
+	if( eWantedParity != serNO_PARITY )
+	{
+		/* The parity select field runs odd, even, forced 1, forced 0, in
+		the same order as eParity. */
+		ucLineControl |= serPARITY_ENABLE;
+		ucLineControl |= ( unsigned char ) ( ( eWantedParity - serODD_PARITY ) << serPARITY_SHIFT );
+	}
+
+	prvSetupPort( pxPort, usDivisors[ eWantedBaud ], ucLineControl );
+
+	return ( xComPortHandle ) pxPort;
+}
+/*-----------------------------------------------------------*/
+
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud )
+{
+unsigned long ulDivisor;
+
+	ulDivisor = prvDivisorFor( ulWantedBaud );
+
+	if( ulDivisor == 0UL )
+	{
+		return NULL;
+	}
+
+	/* UART1, 8 data bits, no parity, 1 stop bit. */
+	prvSetupPort( &xPorts[ serUART1 ], ulDivisor, serMINIMAL_LINE_CONTROL );
+
+	return ( xComPortHandle ) &xPorts[ serUART1 ];
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvDivisorFor( unsigned long ulWantedBaud )
+{
+unsigned portBASE_TYPE uxIndex;
+
+	/* The rates in the table were checked when the driver was built. */
+	for( uxIndex = 0; uxIndex < ( sizeof( ulBaudRates ) / sizeof( ulBaudRates[ 0 ] ) ); uxIndex++ )
+	{
+		if( ulBaudRates[ uxIndex ] == ulWantedBaud )
+		{
+			return ( unsigned long ) usDivisors[ uxIndex ];
+		}
+	}
+
+	/* Anything else is worked out with the same rounding and limits. */
+	if( ( ulWantedBaud == 0UL ) || ( serBAUD_IN_BUDGET( ulWantedBaud ) == 0 ) )
+	{
+		return 0UL;
+	}
+
+	return serDIVISOR( ulWantedBaud );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupPort( xSerialPort *pxPort, unsigned long ulDivisor, unsigned char ucLineControl )
+{
+	portENTER_CRITICAL();
+	{
+		/* Configure the UART pins.  All other pins are left as they are. */
+		PINSEL0 |= pxPort->ulPinSelect;
+
+		/* Setup transmission format.  This also clears the DLAB bit. */
+		serWRITE( pxPort, serLCR, ucLineControl );
+
+		/* Setup the baud rate. */
+		prvSetDivisor( pxPort, ulDivisor );
+
+		/* Turn on the FIFO's, clear the buffers and set the Rx trigger 
+		level. */
+		serWRITE( pxPort, serFCR, ( serFIFO_ON | serCLEAR_FIFO | ( serRX_TRIGGER_DEFAULT << serRX_TRIGGER_SHIFT ) ) );
+
+		/* Setup the VIC for the UART. */
+		VICIntSelect &= ~( 1UL << pxPort->ulVICChannel );
+		VICIntEnable |= ( 1UL << pxPort->ulVICChannel );
+		( &VICVectAddr0 )[ pxPort->ulVICSlot ] = ( unsigned long ) pxPort->pvISREntry;
+		( &VICVectCntl0 )[ pxPort->ulVICSlot ] = pxPort->ulVICChannel | serVIC_ENABLE;
+
+		/* Enable the UART interrupts. */
+		serWRITE( pxPort, serIER, serREAD( pxPort, serIER ) | serENABLE_INTERRUPTS );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetDivisor( xSerialPort *pxPort, unsigned long ulDivisor )
+{
+unsigned char ucLineControl;
 
-	/* Setup the baud rate:  Calculate the divisor value. */
-	ulWantedClock = ulWantedBaud * serWANTED_CLOCK_SCALING;
-	ulDivisor = configCPU_CLOCK_HZ / ulWantedClock;
+	ucLineControl = serREAD( pxPort, serLCR );
 
 	/* Set the DLAB bit so we can access the divisor. */
-	U1LCR |= serDLAB;
+	serWRITE( pxPort, serLCR, ucLineControl | serDLAB );
 
-	/* Setup the divisor. */
-	U1DLL = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
+	serWRITE( pxPort, serDLL, ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff ) );
 	ulDivisor >>= 8;
-	U1DLM = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
+	serWRITE( pxPort, serDLM, ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff ) );
 
-	/* Turn on the FIFO's and clear the buffers. */
-	U1FCR = ( serFIFO_ON | serCLEAR_FIFO );
+	/* Put the line format back, which clears the DLAB bit again. */
+	serWRITE( pxPort, serLCR, ucLineControl & ( unsigned char ) ~serDLAB );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialSetBaud( xComPortHandle pxPort, eBaud eWantedBaud )
+{
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+unsigned char ucStatus;
+
+	if( ( eWantedBaud > ser115200 ) || ( usDivisors[ eWantedBaud ] == 0 ) )
+	{
+		return pdFAIL;
+	}
+
+	/* Let everything already queued go out at the old rate.  The ISR sets
+	xTHREEmpty once the rings and descriptors have run dry, after which the 
+	last character still has to leave the shift register. */
+	for( ;; )
+	{
+		portENTER_CRITICAL();
+		{
+			if( pxSerialPort->xTHREEmpty == pdTRUE )
+			{
+				/* Reading the LSR clears its error bits, so count them. */
+				ucStatus = serREAD( pxSerialPort, serLSR );
+				prvCountLineErrors( pxSerialPort, ucStatus );
 
-	/* Setup transmission format. */
-	U1LCR = serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS;
+				if( ( ucStatus & serTX_EMPTY ) != 0 )
+				{
+					/* Changing the divisor here cannot corrupt a character
+					on its way out, and nothing new is started until the 
+					critical section is left. */
+					prvSetDivisor( pxSerialPort, usDivisors[ eWantedBaud ] );
+					portEXIT_CRITICAL();
+					break;
+				}
+			}
+		}
+		portEXIT_CRITICAL();
+
+		vTaskDelay( 1 );
+	}
 
-	/* Setup the VIC for the UART. */
-	VICIntSelect &= ~( serU1VIC_CHANNEL_BIT );
-	VICIntEnable |= serU1VIC_CHANNEL_BIT;
-	VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
-	VICVectCntl1 = serU1VIC_CHANNEL | serU1VIC_ENABLE;
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
 
-	/* Enable UART0 interrupts. */
-	U1IER |= serENABLE_INTERRUPTS;
+signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar )
+{
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+
+	/* Get the next character from the ring.  Return false if no characters
+	are available. */
+	return prvRingGet( &( pxSerialPort->xRxRing ), ( unsigned char * ) pcRxedChar );
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
+unsigned long xSerialGetBytes( xComPortHandle pxPort, signed char *pcBuffer, unsigned long ulMaxLength )
 {
-	/* Get the next character from the buffer.  Return false if no characters
-	are available, or arrive before xBlockTime expires. */
-	if(isNewCharAvailable == 1U)
+	return prvRingRead( &( ( ( xSerialPort * ) pxPort )->xRxRing ), ( unsigned char * ) pcBuffer, ulMaxLength );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength )
+{
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+xSerialRing *pxRing = &( pxSerialPort->xTxRing );
+unsigned short usIndex;
+
+	if( pcString == NULL )
+	{
+		return pdFALSE;
+	}
+
+	if( usStringLength > ( pxRing->uxMask + 1 ) )
 	{
-		isNewCharAvailable = 0U;
-		*pcRxedChar = receivedChar;
+		/* Longer than the whole ring.  Like the single buffer this driver 
+		used to have, such a string is only taken while nothing else is 
+		waiting to go out.  The ring is filled and the calling task then 
+		blocks, topping it up each time the ISR frees space, until the last
+		character is in. */
+		if( prvRingCount( pxRing ) != 0 )
+		{
+			return pdFALSE;
+		}
+
+		xSerialWrite( pxPort, pcString, ( unsigned long ) usStringLength, portMAX_DELAY );
+
 		return pdTRUE;
 	}
-	else
+
+	/* A string that fits the ring is accepted whole or not at all, without
+	blocking. */
+	if( ( pxRing->uxMask + 1 ) - prvRingCount( pxRing ) < usStringLength )
 	{
 		return pdFALSE;
 	}
+
+	for( usIndex = 0; usIndex < usStringLength; usIndex++ )
+	{
+		prvRingPut( pxRing, ( unsigned char ) pcString[ usIndex ] );
+	}
+
+	prvKickTx( pxSerialPort );
+
+	return pdTRUE;
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+signed portBASE_TYPE xSerialSubmit( xComPortHandle pxPort, xSerialTxDescriptor *pxDescriptor )
 {
-	int i;
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+xSerialTxDescriptor *pxLast;
 
-	if(txDataSizeLeftToSend == 0 && pcString != NULL)
+	if( pxDescriptor == NULL )
 	{
-	  txDataSizeToSend = usStringLength;
-	  txDataSizeLeftToSend = usStringLength;
-	
-	  for(i = 0;i < usStringLength; i++)
-	  {
-		  txBuffer[i] = pcString[i];
-	  }
-	
-	  xSerialPutChar(txBuffer[txDataSizeToSend - txDataSizeLeftToSend--]);
-		
-	  return pdTRUE;
+		return pdFALSE;
+	}
+
+	/* The chain still belongs to the caller, so it can be walked without
+	protection. */
+	for( pxLast = pxDescriptor; ; pxLast = pxLast->pxNext )
+	{
+		pxLast->xComplete = pdFALSE;
+
+		if( pxLast->pxNext == NULL )
+		{
+			break;
+		}
+	}
+
+	/* Append the chain to the port's pending list.  The ISR removes 
+	descriptors from the head of the same list. */
+	portENTER_CRITICAL();
+	{
+		if( pxSerialPort->pxTxHead == NULL )
+		{
+			pxSerialPort->pxTxHead = pxDescriptor;
+			pxSerialPort->ulTxOffset = 0;
+		}
+		else
+		{
+			pxSerialPort->pxTxTail->pxNext = pxDescriptor;
+		}
+
+		pxSerialPort->pxTxTail = pxLast;
+	}
+	portEXIT_CRITICAL();
+
+	prvKickTx( pxSerialPort );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvKickTx( xSerialPort *pxPort )
+{
+	/* If the THRE is empty the ISR is not transmitting and will not run 
+	again until something is written to the Tx FIFO.  Enabling the THRE
+	interrupt while the Tx FIFO is empty raises it straight away, so the ISR 
+	starts the transmission off and remains the only consumer of the Tx ring
+	and the descriptor list.  Descriptor callbacks therefore always run in 
+	the ISR. */
+	if( pxPort->xTHREEmpty == pdTRUE )
+	{
+		pxPort->xTHREEmpty = pdFALSE;
+		serWRITE( pxPort, serIER, serREAD( pxPort, serIER ) & ~serTHRE_INTERRUPT );
+		serWRITE( pxPort, serIER, serREAD( pxPort, serIER ) | serTHRE_INTERRUPT );
 	}
-	else
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed char cOutChar )
+{
+	return vSerialPutString( pxPort, &cOutChar, 1 );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long xSerialRead( xComPortHandle pxPort, signed char *pcBuffer, unsigned long ulLength, TickType_t xBlockTime )
+{
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+xSerialRing *pxRing = &( pxSerialPort->xRxRing );
+unsigned long ulCount = 0;
+unsigned portBASE_TYPE uxWanted;
+TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		ulCount += prvRingRead( pxRing, ( unsigned char * ) &( pcBuffer[ ulCount ] ), ulLength - ulCount );
+
+		if( ulCount == ulLength )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			break;
+		}
+
+		/* Wait for the rest of the request, or for a full ring if the rest 
+		will not fit in it. */
+		uxWanted = pxRing->uxMask + 1;
+
+		if( ( ulLength - ulCount ) < uxWanted )
+		{
+			uxWanted = ( unsigned portBASE_TYPE ) ( ulLength - ulCount );
+		}
+
+		/* Register with the ISR, then check the ring again in case the 
+		characters arrived before the ISR could see the registration. */
+		pxSerialPort->uxRxWanted = uxWanted;
+		pxSerialPort->xRxWaitingTask = xTaskGetCurrentTaskHandle();
+
+		if( prvRingCount( pxRing ) < uxWanted )
+		{
+			ulTaskNotifyTake( pdTRUE, xBlockTime );
+		}
+
+		pxSerialPort->xRxWaitingTask = NULL;
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long xSerialWrite( xComPortHandle pxPort, const signed char *pcBuffer, unsigned long ulLength, TickType_t xBlockTime )
+{
+xSerialPort *pxSerialPort = ( xSerialPort * ) pxPort;
+xSerialRing *pxRing = &( pxSerialPort->xTxRing );
+unsigned long ulCount = 0;
+TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		while( ( ulCount < ulLength ) && ( prvRingPut( pxRing, ( unsigned char ) pcBuffer[ ulCount ] ) != pdFALSE ) )
+		{
+			ulCount++;
+		}
+
+		prvKickTx( pxSerialPort );
+
+		if( ulCount == ulLength )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			break;
+		}
+
+		/* The ring is full.  Register with the ISR, which will notify this 
+		task the next time it takes characters out of the ring, then check 
+		again in case it already has. */
+		pxSerialPort->xTxWaitingTask = xTaskGetCurrentTaskHandle();
+
+		if( prvRingCount( pxRing ) > pxRing->uxMask )
+		{
+			ulTaskNotifyTake( pdTRUE, xBlockTime );
+		}
+
+		pxSerialPort->xTxWaitingTask = NULL;
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+void vSerialSetRxTrigger( xComPortHandle pxPort, eRxTrigger eTriggerLevel )
+{
+	/* The FIFO enable bit must be written with the trigger level. */
+	serWRITE( ( xSerialPort * ) pxPort, serFCR, ( serFIFO_ON | ( ( unsigned char ) eTriggerLevel << serRX_TRIGGER_SHIFT ) ) );
+}
+/*-----------------------------------------------------------*/
+
+void vSerialGetStats( xComPortHandle pxPort, xSerialStats *pxStats )
+{
+	portENTER_CRITICAL();
+	{
+		*pxStats = ( ( xSerialPort * ) pxPort )->xStats;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRingPut( xSerialRing *pxRing, unsigned char ucChar )
+{
+unsigned portBASE_TYPE uxHead = pxRing->uxHead;
+
+	if( ( uxHead - pxRing->uxTail ) > pxRing->uxMask )
+	{
+		return pdFALSE;
+	}
+
+	/* Store the character before publishing the new head so the consumer
+	never sees a slot that has not been written yet. */
+	pxRing->pucBuffer[ uxHead & pxRing->uxMask ] = ucChar;
+	pxRing->uxHead = uxHead + 1;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRingGet( xSerialRing *pxRing, unsigned char *pucChar )
+{
+unsigned portBASE_TYPE uxTail = pxRing->uxTail;
+
+	if( uxTail == pxRing->uxHead )
 	{
 		return pdFALSE;
 	}
+
+	*pucChar = pxRing->pucBuffer[ uxTail & pxRing->uxMask ];
+	pxRing->uxTail = uxTail + 1;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRingRead( xSerialRing *pxRing, unsigned char *pucBuffer, unsigned long ulMaxLength )
+{
+unsigned portBASE_TYPE uxTail = pxRing->uxTail;
+unsigned portBASE_TYPE uxIndex = uxTail & pxRing->uxMask;
+unsigned long ulCount, ulFirst;
+
+	ulCount = ( unsigned long ) ( pxRing->uxHead - uxTail );
+
+	if( ulCount > ulMaxLength )
+	{
+		ulCount = ulMaxLength;
+	}
+
+	/* Copy up to the end of the storage, then any remainder from the 
+	start, and only then release the space to the producer. */
+	ulFirst = ( unsigned long ) ( pxRing->uxMask + 1 - uxIndex );
+
+	if( ulFirst > ulCount )
+	{
+		ulFirst = ulCount;
+	}
+
+	memcpy( pucBuffer, &( pxRing->pucBuffer[ uxIndex ] ), ulFirst );
+	memcpy( &( pucBuffer[ ulFirst ] ), pxRing->pucBuffer, ulCount - ulFirst );
+	pxRing->uxTail = uxTail + ( unsigned portBASE_TYPE ) ulCount;
+
+	return ulCount;
 }
 /*-----------------------------------------------------------*/
 
-void xSerialPutChar(signed char cOutChar)
+static unsigned portBASE_TYPE prvFillTxFifo( xSerialPort *pxPort, portBASE_TYPE *pxHigherPriorityTaskWoken )
 {
-	U1THR = cOutChar;
+unsigned portBASE_TYPE uxCount = 0, uxRingCount;
+unsigned char ucChar;
+xSerialTxDescriptor *pxDescriptor;
+
+	/* Stream from the pending descriptors first. */
+	while( ( uxCount < serTX_FIFO_LENGTH ) && ( pxPort->pxTxHead != NULL ) )
+	{
+		pxDescriptor = pxPort->pxTxHead;
+
+		while( ( uxCount < serTX_FIFO_LENGTH ) && ( pxPort->ulTxOffset < pxDescriptor->ulLength ) )
+		{
+			serWRITE( pxPort, serTHR, pxDescriptor->pucData[ pxPort->ulTxOffset ] );
+			pxPort->ulTxOffset++;
+			uxCount++;
+		}
+
+		if( pxPort->ulTxOffset == pxDescriptor->ulLength )
+		{
+			/* All of this descriptor's data is in the FIFO, so the caller 
+			can have it back. */
+			pxPort->pxTxHead = pxDescriptor->pxNext;
+			pxPort->ulTxOffset = 0;
+			pxDescriptor->xComplete = pdTRUE;
+
+			if( pxDescriptor->pvCallback != NULL )
+			{
+				pxDescriptor->pvCallback( pxDescriptor, pxHigherPriorityTaskWoken );
+			}
+		}
+	}
+
+	/* Then from the Tx ring. */
+	for( uxRingCount = 0; uxCount < serTX_FIFO_LENGTH; uxCount++, uxRingCount++ )
+	{
+		if( prvRingGet( &( pxPort->xTxRing ), &ucChar ) == pdFALSE )
+		{
+			break;
+		}
+
+		serWRITE( pxPort, serTHR, ucChar );
+	}
+
+	/* Space was made in the Tx ring, so a blocked writer can continue. */
+	if( ( uxRingCount != 0 ) && ( pxPort->xTxWaitingTask != NULL ) )
+	{
+		vTaskNotifyGiveFromISR( pxPort->xTxWaitingTask, pxHigherPriorityTaskWoken );
+	}
+
+	pxPort->xStats.ulTxBytes += uxCount;
+
+	if( uxCount != 0 )
+	{
+		pxPort->xStats.ulTxRefills++;
+	}
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountLineErrors( xSerialPort *pxPort, unsigned char ucStatus )
+{
+	if( ( ucStatus & serLINE_ERRORS ) != 0 )
+	{
+		if( ( ucStatus & serOVERRUN_ERROR ) != 0 )
+		{
+			pxPort->xStats.ulOverrunErrors++;
+		}
+
+		if( ( ucStatus & serPARITY_ERROR ) != 0 )
+		{
+			pxPort->xStats.ulParityErrors++;
+		}
+
+		if( ( ucStatus & serFRAMING_ERROR ) != 0 )
+		{
+			pxPort->xStats.ulFramingErrors++;
+		}
+
+		if( ( ucStatus & serBREAK_INTERRUPT ) != 0 )
+		{
+			pxPort->xStats.ulBreaks++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vUART0_ISRHandler( void )
+{
+	/* If a task was woken the asm wrapper restores its context instead. */
+	portEXIT_SWITCHING_ISR( prvUARTHandler( &xPorts[ serUART0 ] ) );
 }
 /*-----------------------------------------------------------*/
 
 void vUART_ISRHandler( void )
 {
-signed char cChar;
+	portEXIT_SWITCHING_ISR( prvUARTHandler( &xPorts[ serUART1 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUARTHandler( xSerialPort *pxPort )
+{
+unsigned char ucChar;
 unsigned char ucInterrupt;
+unsigned char ucStatus;
+unsigned portBASE_TYPE uxDepth;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	pxPort->xStats.ulInterrupts++;
 
-	ucInterrupt = U1IIR;
+	ucInterrupt = serREAD( pxPort, serIIR );
 
 	/* The interrupt pending bit is active low. */
 	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
@@ -193,42 +946,67 @@ unsigned char ucInterrupt;
 		/* What caused the interrupt? */
 		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
 		{
-			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
-				cChar = U1LSR;
+			case serSOURCE_ERROR :	/* Reading the LSR clears the interrupt. */
+				prvCountLineErrors( pxPort, serREAD( pxPort, serLSR ) );
 				break;
 	
-			case serSOURCE_THRE	:	/* The THRE is empty */
+			case serSOURCE_THRE	:	/* The Tx FIFO is empty, refill it */
 				
-				/* Do nothing */
-				if(txDataSizeLeftToSend > 0)
+				if( prvFillTxFifo( pxPort, &xHigherPriorityTaskWoken ) == 0 )
 				{
-					U1THR = txBuffer[txDataSizeToSend - txDataSizeLeftToSend--];
+					/* Nothing left to send, the next write has to restart
+					the transmitter. */
+					pxPort->xTHREEmpty = pdTRUE;
 				}
-				
 				break;
 	
 			case serSOURCE_RX_TIMEOUT :
-			case serSOURCE_RX	:	/* A character was received */
+			case serSOURCE_RX	:	/* Characters were received, drain the Rx FIFO */
 			
-				receivedChar = U1RBR;
-				isNewCharAvailable = 1U;			
+				for( ;; )
+				{
+					ucStatus = serREAD( pxPort, serLSR );
+					prvCountLineErrors( pxPort, ucStatus );
+
+					if( ( ucStatus & serDATA_READY ) == 0 )
+					{
+						break;
+					}
+
+					ucChar = serREAD( pxPort, serRBR );
+					pxPort->xStats.ulRxBytes++;
+
+					/* The character is dropped if the Rx ring is full. */
+					if( prvRingPut( &( pxPort->xRxRing ), ucChar ) == pdFALSE )
+					{
+						pxPort->xStats.ulRxDropped++;
+					}
+				}
+
+				uxDepth = prvRingCount( &( pxPort->xRxRing ) );
+
+				if( uxDepth > pxPort->xStats.ulRxHighWater )
+				{
+					pxPort->xStats.ulRxHighWater = uxDepth;
+				}
+
+				/* Wake a blocked reader once its request can be met. */
+				if( ( pxPort->xRxWaitingTask != NULL ) && ( uxDepth >= pxPort->uxRxWanted ) )
+				{
+					vTaskNotifyGiveFromISR( pxPort->xRxWaitingTask, &xHigherPriorityTaskWoken );
+				}
 				break;
 	
 			default:	/* There is nothing to do, leave the ISR. */
 				break;
 		}
 
-		ucInterrupt = U1IIR;
+		ucInterrupt = serREAD( pxPort, serIIR );
 	}
 
 	/* Clear the ISR in the VIC. */
 	VICVectAddr = serCLEAR_VIC_INTERRUPT;
+
+	return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
-
-
-
-
-
-
-	
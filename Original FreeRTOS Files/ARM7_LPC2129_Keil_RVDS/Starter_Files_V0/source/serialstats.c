@@ -0,0 +1,141 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Periodic dump of the counters kept by serial.c.
+ *
+ * vStartSerialStatsTask() creates a single task that wakes every xPeriod 
+ * ticks, reads the counters of the monitored port with vSerialGetStats() and
+ * writes one line per period to the report port, for example:
+ *
+ *     tx=11520 rx=11520 drop=0 peak=17 oe=0 pe=0 fe=0 bi=0 int=1455 burst=15
+ *
+ * tx, rx, drop and int are the increases since the previous line, peak is the
+ * deepest the Rx ring has ever been and burst is the average number of 
+ * characters written to the Tx FIFO per refill over the period.  The error 
+ * counters are totals.  The monitored and report ports can be the same, in 
+ * which case the report's own characters show up in the next line's tx count.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "strfmt.h"
+#include "serialstats.h"
+
+#define statsSTACK_SIZE				configMINIMAL_STACK_SIZE
+/* The 49 characters of the labels and line end, ten numbers and the NUL. */
+#define statsREPORT_LENGTH			( 49 + ( 10 * strfmtMAX_DIGITS ) + 1 )
+
+/*-----------------------------------------------------------*/
+
+static void vSerialStatsTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xComPortHandle xMonitoredPort = NULL;
+static xComPortHandle xReportPort = NULL;
+static TickType_t xReportPeriod;
+
+/* Kept off the task's stack, which is only the minimal size. */
+static xSerialStats xPrevious, xCurrent;
+static char cReport[ statsREPORT_LENGTH ];
+
+/* The task's stack and TCB. */
+static StackType_t xStatsStack[ statsSTACK_SIZE ];
+static StaticTask_t xStatsTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartSerialStatsTask( xComPortHandle pxPort, xComPortHandle pxReportPort, unsigned portBASE_TYPE uxPriority, TickType_t xPeriod )
+{
+	xMonitoredPort = pxPort;
+	xReportPort = pxReportPort;
+	xReportPeriod = xPeriod;
+
+	xTaskCreateStatic( vSerialStatsTask, "SerStat", statsSTACK_SIZE, NULL, uxPriority, xStatsStack, &xStatsTCB );
+}
+/*-----------------------------------------------------------*/
+
+static void vSerialStatsTask( void *pvParameters )
+{
+TickType_t xLastWakeTime;
+unsigned long ulRefills;
+char *pcNext;
+
+	( void ) pvParameters;
+
+	vSerialGetStats( xMonitoredPort, &xPrevious );
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xReportPeriod );
+		vSerialGetStats( xMonitoredPort, &xCurrent );
+
+		ulRefills = xCurrent.ulTxRefills - xPrevious.ulTxRefills;
+		if( ulRefills == 0UL )
+		{
+			ulRefills = 1UL;
+		}
+
+		pcNext = pcStrFmtAppendString( cReport, "tx=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulTxBytes - xPrevious.ulTxBytes );
+		pcNext = pcStrFmtAppendString( pcNext, " rx=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulRxBytes - xPrevious.ulRxBytes );
+		pcNext = pcStrFmtAppendString( pcNext, " drop=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulRxDropped - xPrevious.ulRxDropped );
+		pcNext = pcStrFmtAppendString( pcNext, " peak=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulRxHighWater );
+		pcNext = pcStrFmtAppendString( pcNext, " oe=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulOverrunErrors );
+		pcNext = pcStrFmtAppendString( pcNext, " pe=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulParityErrors );
+		pcNext = pcStrFmtAppendString( pcNext, " fe=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulFramingErrors );
+		pcNext = pcStrFmtAppendString( pcNext, " bi=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulBreaks );
+		pcNext = pcStrFmtAppendString( pcNext, " int=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, xCurrent.ulInterrupts - xPrevious.ulInterrupts );
+		pcNext = pcStrFmtAppendString( pcNext, " burst=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ( xCurrent.ulTxBytes - xPrevious.ulTxBytes ) / ulRefills );
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+		configASSERT( ( unsigned long ) ( pcNext - cReport ) < statsREPORT_LENGTH );
+
+		xPrevious = xCurrent;
+
+		/* Wait for space rather than lose the line, but never for longer 
+		than a period. */
+		xSerialWrite( xReportPort, ( signed char * ) cReport, ( unsigned long ) ( pcNext - cReport ), xReportPeriod );
+	}
+}
+/*-----------------------------------------------------------*/
+
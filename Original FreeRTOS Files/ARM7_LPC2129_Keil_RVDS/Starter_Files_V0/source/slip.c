@@ -0,0 +1,316 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * SLIP packet framing with a CRC16 for the serial driver in serial.c.
+ *
+ * Each packet goes out as
+ *
+ *     END | payload | CRC high | CRC low | END
+ *
+ * with any END or ESC byte in the payload or CRC replaced by a two byte 
+ * escape sequence, as in RFC 1055.  The leading END flushes any noise the 
+ * receiver has collected since the last packet.  The CRC is CRC-16/CCITT sent
+ * most significant byte first, so running the CRC over the payload and CRC 
+ * together leaves zero for an intact packet.
+ *
+ * Neither direction holds a whole frame.  xSlipSend() escapes through a 
+ * small chunk buffer that is handed to xSerialWrite() whenever it fills.  The
+ * decoder takes one byte at a time from the Rx ring, unescaping into the 
+ * caller's buffer and updating the CRC as it goes, so a packet is ready the
+ * moment its END arrives.  Losing a byte costs only the packet it was in: 
+ * the next END resynchronises the decoder.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "slip.h"
+
+#define slipEND						( ( unsigned char ) 0xc0 )
+#define slipESC						( ( unsigned char ) 0xdb )
+#define slipESC_END					( ( unsigned char ) 0xdc )
+#define slipESC_ESC					( ( unsigned char ) 0xdd )
+
+#define slipCRC_INITIAL_VALUE		( ( unsigned short ) 0xffff )
+
+/* Size of the buffer used to pass escaped data to the serial driver. */
+#define slipCHUNK_LENGTH			( 16 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add a byte to the CRC.
+ */
+static unsigned short prvCRCByte( unsigned short usCRC, unsigned char ucByte );
+
+/*
+ * Add a byte to the chunk being built by xSlipSend(), escaping it if 
+ * necessary and writing the chunk out when it is full.  Returns pdFAIL if the
+ * write timed out.
+ */
+static portBASE_TYPE prvSendByte( xComPortHandle pxPort, unsigned char *pucChunk, unsigned portBASE_TYPE *puxChunkLength, unsigned char ucByte, portBASE_TYPE xEscape, TimeOut_t *pxTimeOut, TickType_t *pxBlockTime );
+
+/*-----------------------------------------------------------*/
+
+/* CRC-16/CCITT remainders for each value of a nibble.  Half the work of a 
+byte table for 32 rather than 512 bytes of flash. */
+static const unsigned short usCRCNibbleTable[ 16 ] =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+	0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+};
+
+/*-----------------------------------------------------------*/
+
+static unsigned short prvCRCByte( unsigned short usCRC, unsigned char ucByte )
+{
+	usCRC = ( unsigned short ) ( ( usCRC << 4 ) ^ usCRCNibbleTable[ ( ( usCRC >> 12 ) ^ ( ucByte >> 4 ) ) & 0x0f ] );
+	usCRC = ( unsigned short ) ( ( usCRC << 4 ) ^ usCRCNibbleTable[ ( ( usCRC >> 12 ) ^ ucByte ) & 0x0f ] );
+
+	return usCRC;
+}
+/*-----------------------------------------------------------*/
+
+unsigned short usSlipCRC( unsigned short usCRC, const unsigned char *pucData, unsigned long ulLength )
+{
+	while( ulLength > 0UL )
+	{
+		usCRC = prvCRCByte( usCRC, *pucData );
+		pucData++;
+		ulLength--;
+	}
+
+	return usCRC;
+}
+/*-----------------------------------------------------------*/
+
+void vSlipDecoderInit( xSlipDecoder *pxDecoder, unsigned char *pucBuffer, unsigned short usBufferLength )
+{
+	pxDecoder->pucBuffer = pucBuffer;
+	pxDecoder->usBufferLength = usBufferLength;
+	pxDecoder->usLength = 0;
+	pxDecoder->usCRC = slipCRC_INITIAL_VALUE;
+	pxDecoder->xEscaped = pdFALSE;
+	pxDecoder->xDiscarding = pdFALSE;
+	pxDecoder->ulPackets = 0UL;
+	pxDecoder->ulCRCErrors = 0UL;
+	pxDecoder->ulOverflows = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+unsigned short usSlipDecodeByte( xSlipDecoder *pxDecoder, unsigned char ucByte )
+{
+unsigned short usPayloadLength = 0;
+
+	if( ucByte == slipEND )
+	{
+		/* End of a frame.  Empty frames are the separators between packets
+		and are ignored. */
+		if( pxDecoder->xDiscarding != pdFALSE )
+		{
+			pxDecoder->ulOverflows++;
+		}
+		else if( pxDecoder->usLength != 0 )
+		{
+			if( ( pxDecoder->usLength > slipCRC_LENGTH ) && ( pxDecoder->usCRC == 0 ) )
+			{
+				usPayloadLength = ( unsigned short ) ( pxDecoder->usLength - slipCRC_LENGTH );
+				pxDecoder->ulPackets++;
+			}
+			else
+			{
+				pxDecoder->ulCRCErrors++;
+			}
+		}
+
+		pxDecoder->usLength = 0;
+		pxDecoder->usCRC = slipCRC_INITIAL_VALUE;
+		pxDecoder->xEscaped = pdFALSE;
+		pxDecoder->xDiscarding = pdFALSE;
+	}
+	else if( ucByte == slipESC )
+	{
+		pxDecoder->xEscaped = pdTRUE;
+	}
+	else if( pxDecoder->xDiscarding == pdFALSE )
+	{
+		if( pxDecoder->xEscaped != pdFALSE )
+		{
+			/* Anything other than the two escape codes after an ESC is a
+			protocol violation.  Pass it through and let the CRC catch it. */
+			if( ucByte == slipESC_END )
+			{
+				ucByte = slipEND;
+			}
+			else if( ucByte == slipESC_ESC )
+			{
+				ucByte = slipESC;
+			}
+
+			pxDecoder->xEscaped = pdFALSE;
+		}
+
+		if( pxDecoder->usLength < pxDecoder->usBufferLength )
+		{
+			pxDecoder->pucBuffer[ pxDecoder->usLength ] = ucByte;
+			pxDecoder->usLength++;
+			pxDecoder->usCRC = prvCRCByte( pxDecoder->usCRC, ucByte );
+		}
+		else
+		{
+			/* Skip to the next END. */
+			pxDecoder->xDiscarding = pdTRUE;
+		}
+	}
+
+	return usPayloadLength;
+}
+/*-----------------------------------------------------------*/
+
+unsigned short usSlipReceive( xComPortHandle pxPort, xSlipDecoder *pxDecoder, TickType_t xBlockTime )
+{
+signed char cByte;
+unsigned short usPayloadLength;
+TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		/* Bytes are taken from the Rx ring one at a time so nothing after the
+		END of this packet is consumed. */
+		if( xSerialGetChar( pxPort, &cByte ) == pdFALSE )
+		{
+			/* Nothing waiting, so block until at least one byte arrives. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+			{
+				return 0;
+			}
+
+			if( xSerialRead( pxPort, &cByte, 1UL, xBlockTime ) == 0UL )
+			{
+				continue;
+			}
+		}
+
+		usPayloadLength = usSlipDecodeByte( pxDecoder, ( unsigned char ) cByte );
+
+		if( usPayloadLength != 0 )
+		{
+			return usPayloadLength;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSlipSend( xComPortHandle pxPort, const unsigned char *pucData, unsigned short usLength, TickType_t xBlockTime )
+{
+unsigned char ucChunk[ slipCHUNK_LENGTH ];
+unsigned portBASE_TYPE uxChunkLength = 0;
+unsigned short usCRC, usIndex;
+portBASE_TYPE xReturn;
+TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+	usCRC = usSlipCRC( slipCRC_INITIAL_VALUE, pucData, usLength );
+
+	xReturn = prvSendByte( pxPort, ucChunk, &uxChunkLength, slipEND, pdFALSE, &xTimeOut, &xBlockTime );
+
+	for( usIndex = 0; ( usIndex < usLength ) && ( xReturn == pdPASS ); usIndex++ )
+	{
+		xReturn = prvSendByte( pxPort, ucChunk, &uxChunkLength, pucData[ usIndex ], pdTRUE, &xTimeOut, &xBlockTime );
+	}
+
+	if( xReturn == pdPASS )
+	{
+		xReturn = prvSendByte( pxPort, ucChunk, &uxChunkLength, ( unsigned char ) ( usCRC >> 8 ), pdTRUE, &xTimeOut, &xBlockTime );
+	}
+
+	if( xReturn == pdPASS )
+	{
+		xReturn = prvSendByte( pxPort, ucChunk, &uxChunkLength, ( unsigned char ) ( usCRC & 0xff ), pdTRUE, &xTimeOut, &xBlockTime );
+	}
+
+	if( xReturn == pdPASS )
+	{
+		xReturn = prvSendByte( pxPort, ucChunk, &uxChunkLength, slipEND, pdFALSE, &xTimeOut, &xBlockTime );
+	}
+
+	/* Flush what is left of the last chunk. */
+	if( ( xReturn == pdPASS ) && ( uxChunkLength != 0 ) )
+	{
+		xTaskCheckForTimeOut( &xTimeOut, &xBlockTime );
+
+		if( xSerialWrite( pxPort, ( signed char * ) ucChunk, uxChunkLength, xBlockTime ) != uxChunkLength )
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSendByte( xComPortHandle pxPort, unsigned char *pucChunk, unsigned portBASE_TYPE *puxChunkLength, unsigned char ucByte, portBASE_TYPE xEscape, TimeOut_t *pxTimeOut, TickType_t *pxBlockTime )
+{
+	/* Make room for an escape sequence. */
+	if( *puxChunkLength > ( slipCHUNK_LENGTH - 2 ) )
+	{
+		xTaskCheckForTimeOut( pxTimeOut, pxBlockTime );
+
+		if( xSerialWrite( pxPort, ( signed char * ) pucChunk, *puxChunkLength, *pxBlockTime ) != *puxChunkLength )
+		{
+			return pdFAIL;
+		}
+
+		*puxChunkLength = 0;
+	}
+
+	if( ( xEscape != pdFALSE ) && ( ucByte == slipEND ) )
+	{
+		pucChunk[ ( *puxChunkLength )++ ] = slipESC;
+		pucChunk[ ( *puxChunkLength )++ ] = slipESC_END;
+	}
+	else if( ( xEscape != pdFALSE ) && ( ucByte == slipESC ) )
+	{
+		pucChunk[ ( *puxChunkLength )++ ] = slipESC;
+		pucChunk[ ( *puxChunkLength )++ ] = slipESC_ESC;
+	}
+	else
+	{
+		pucChunk[ ( *puxChunkLength )++ ] = ucByte;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,296 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Stack high water monitor and sizing report.
+ *
+ * Every stack starts out painted with stackmonPAINT, and the paint left
+ * untouched at its far end is the least of it that has ever been free.  For
+ * tasks the kernel works that out, see uxTaskGetSystemState(), and this file
+ * only remembers how big each stack is.  The ARM mode stacks Startup.s sets
+ * up are scanned here.  vStartStackMonitorTask() creates a single task that
+ * wakes every xPeriod ticks and writes one line per stack, for example:
+ *
+ *     stack task=LED Toggle size=360 free=212 rec=192
+ *     stack mode=IRQ size=768 free=704 rec=96
+ *
+ * All in bytes.  rec is the deepest use seen plus a margin, rounded up to the
+ * eight bytes the ARM procedure call standard aligns stacks to, or the size
+ * itself for a stack that has not been touched yet.  A task
+ * stack's size is given in words, a quarter of what is printed.
+ * The mode stacks' sizes are the *_Stack_Size values in Startup.s.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "serial.h"
+#include "strfmt.h"
+#include "stackmon.h"
+
+#define stackmonSTACK_SIZE			configMINIMAL_STACK_SIZE
+#define stackmonMAX_TASKS			( 12 )
+#define stackmonLINE_LENGTH			( configMAX_TASK_NAME_LEN + 48 )
+#define stackmonWORD_BYTES			( sizeof( StackType_t ) )
+
+/* The mode stacks, from the bottom of Stack_Mem up, as Startup.s lays them
+out.  The host build has none. */
+#ifndef stackmonMODE_STACKS
+	#define stackmonMODE_STACKS		1
+#endif
+
+#define stackmonNUM_MODES			( 6 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct STACK_MONITOR_TASK
+{
+	void *pvTask;
+	unsigned long ulStackWords;
+} xStackMonitorTask;
+
+static void vStackMonitorTask( void *pvParameters );
+
+/*
+ * The size of pvTask's stack in words, 0 if it was never recorded.
+ */
+static unsigned long prvStackWords( void *pvTask );
+
+/*
+ * Write one line of the report.
+ */
+static void prvReport( const char *pcKind, const char *pcName, unsigned long ulSize, unsigned long ulFree );
+
+/*-----------------------------------------------------------*/
+
+#if( stackmonMODE_STACKS == 1 )
+	/* From Startup.s. */
+	extern unsigned long Stack_Mem[];
+	extern const unsigned long ulStartupStackSizes[ stackmonNUM_MODES ];
+
+	static const char * const pcModeNames[ stackmonNUM_MODES ] = { "USR", "SVC", "IRQ", "FIQ", "ABT", "UND" };
+#endif
+
+static xComPortHandle xReportPort = NULL;
+static SemaphoreHandle_t xReportMutex = NULL;
+static TickType_t xReportPeriod;
+
+/* Written by the kernel as tasks come and go, with interrupts masked. */
+static xStackMonitorTask xTasks[ stackmonMAX_TASKS ];
+
+/* Kept off the task's stack, which is only the minimal size. */
+static TaskStatus_t xStatus[ stackmonMAX_TASKS ];
+static char cLine[ stackmonLINE_LENGTH ];
+
+/* The task's own stack and TCB. */
+static StackType_t xMonitorStack[ stackmonSTACK_SIZE ];
+static StaticTask_t xMonitorTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartStackMonitorTask( xComPortHandle pxReportPort, SemaphoreHandle_t xPortMutex, unsigned portBASE_TYPE uxPriority, TickType_t xPeriod )
+{
+	xReportPort = pxReportPort;
+	xReportMutex = xPortMutex;
+	xReportPeriod = xPeriod;
+
+	xTaskCreateStatic( vStackMonitorTask, "StkMon", stackmonSTACK_SIZE, NULL, uxPriority, xMonitorStack, &xMonitorTCB );
+}
+/*-----------------------------------------------------------*/
+
+void vStackMonitorTaskCreated( void *pvTask, unsigned long ulStackWords )
+{
+unsigned portBASE_TYPE ux;
+
+	/* A task that finds no room is reported without a size. */
+	for( ux = 0; ux < stackmonMAX_TASKS; ux++ )
+	{
+		if( xTasks[ ux ].pvTask == NULL )
+		{
+			xTasks[ ux ].pvTask = pvTask;
+			xTasks[ ux ].ulStackWords = ulStackWords;
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStackMonitorTaskDeleted( void *pvTask )
+{
+unsigned portBASE_TYPE ux;
+
+	for( ux = 0; ux < stackmonMAX_TASKS; ux++ )
+	{
+		if( xTasks[ ux ].pvTask == pvTask )
+		{
+			xTasks[ ux ].pvTask = NULL;
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vStackMonitorTask( void *pvParameters )
+{
+TickType_t xLastWakeTime;
+unsigned portBASE_TYPE uxTasks, ux;
+#if( stackmonMODE_STACKS == 1 )
+	const unsigned long *pulWord;
+	unsigned long ulBottom, ulWords, ulFree;
+#endif
+
+	( void ) pvParameters;
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xReportPeriod );
+
+		/* Returns 0, and fills in nothing, if there are more tasks than
+		room for them. */
+		uxTasks = uxTaskGetSystemState( xStatus, stackmonMAX_TASKS, NULL );
+		configASSERT( uxTasks != 0 );
+
+		/* The report goes out in one piece, whoever else shares the port. */
+		if( xReportMutex != NULL )
+		{
+			xSemaphoreTake( xReportMutex, portMAX_DELAY );
+		}
+
+		for( ux = 0; ux < uxTasks; ux++ )
+		{
+			prvReport( "task", xStatus[ ux ].pcTaskName, prvStackWords( xStatus[ ux ].xHandle ) * stackmonWORD_BYTES, ( unsigned long ) xStatus[ ux ].usStackHighWaterMark * stackmonWORD_BYTES );
+		}
+
+		#if( stackmonMODE_STACKS == 1 )
+		{
+			/* Each mode stack grows down from the top of its part of
+			Stack_Mem, so the paint that is left is at the bottom. */
+			ulBottom = 0UL;
+
+			for( ux = 0; ux < stackmonNUM_MODES; ux++ )
+			{
+				ulWords = ulStartupStackSizes[ ux ] / sizeof( unsigned long );
+				pulWord = &( Stack_Mem[ ulBottom ] );
+				ulFree = 0UL;
+
+				while( ( ulFree < ulWords ) && ( pulWord[ ulFree ] == stackmonPAINT ) )
+				{
+					ulFree++;
+				}
+
+				prvReport( "mode", pcModeNames[ ux ], ulStartupStackSizes[ ux ], ulFree * sizeof( unsigned long ) );
+				ulBottom += ulWords;
+			}
+		}
+		#endif
+
+		if( xReportMutex != NULL )
+		{
+			xSemaphoreGive( xReportMutex );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvStackWords( void *pvTask )
+{
+unsigned long ulWords = 0UL;
+unsigned portBASE_TYPE ux;
+
+	portENTER_CRITICAL();
+	{
+		for( ux = 0; ux < stackmonMAX_TASKS; ux++ )
+		{
+			if( xTasks[ ux ].pvTask == pvTask )
+			{
+				ulWords = xTasks[ ux ].ulStackWords;
+				break;
+			}
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return ulWords;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char *pcKind, const char *pcName, unsigned long ulSize, unsigned long ulFree )
+{
+unsigned long ulUsed, ulMargin, ulRecommended;
+char *pcNext;
+
+	pcNext = pcStrFmtAppendString( cLine, "stack " );
+	pcNext = pcStrFmtAppendString( pcNext, pcKind );
+	pcNext = pcStrFmtAppendString( pcNext, "=" );
+	pcNext = pcStrFmtAppendString( pcNext, pcName );
+
+	/* Without a size nothing more can be said than how much is free. */
+	if( ulSize != 0UL )
+	{
+		pcNext = pcStrFmtAppendString( pcNext, " size=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulSize );
+	}
+
+	pcNext = pcStrFmtAppendString( pcNext, " free=" );
+	pcNext = pcStrFmtAppendNumber( pcNext, ulFree );
+
+	if( ulSize != 0UL )
+	{
+		ulUsed = ( ulFree < ulSize ) ? ( ulSize - ulFree ) : 0UL;
+		ulMargin = ulUsed / stackmonMARGIN_DIVISOR;
+
+		if( ulMargin < stackmonMIN_MARGIN_BYTES )
+		{
+			ulMargin = stackmonMIN_MARGIN_BYTES;
+		}
+
+		ulRecommended = ( ulUsed + ulMargin + 7UL ) & ~7UL;
+
+		/* Nothing has been learnt about a stack that was never used, the
+		FIQ, abort and undefined mode ones for example. */
+		if( ulUsed == 0UL )
+		{
+			ulRecommended = ulSize;
+		}
+
+		pcNext = pcStrFmtAppendString( pcNext, " rec=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulRecommended );
+	}
+
+	pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+
+	/* Wait for space rather than lose the line, but never for longer than a
+	period. */
+	xSerialWrite( xReportPort, ( signed char * ) cLine, ( unsigned long ) ( pcNext - cLine ), xReportPeriod );
+}
+/*-----------------------------------------------------------*/
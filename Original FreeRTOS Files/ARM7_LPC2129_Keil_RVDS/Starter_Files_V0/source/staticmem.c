@@ -0,0 +1,62 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Memory for the kernel's own task.
+ *
+ * Every task, queue and semaphore is created with its ...Static() function
+ * from storage its module declares, so the applications are built with
+ * configSUPPORT_DYNAMIC_ALLOCATION set to 0 and without a heap_x.c.  All of 
+ * their RAM is then in the linker's RW_IRAM1 region, and an application that
+ * needs more than the part has fails to link rather than to create a task at
+ * run time.  The map file's ZI-data is the whole of what is used.
+ *
+ * The kernel asks for the idle task's stack and TCB here as it starts.  There
+ * is no timer task, configUSE_TIMERS is left at 0.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+static StackType_t xIdleStack[ configMINIMAL_STACK_SIZE ];
+static StaticTask_t xIdleTCB;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+	*ppxIdleTaskTCBBuffer = &xIdleTCB;
+	*ppxIdleTaskStackBuffer = xIdleStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -0,0 +1,79 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * The string building shared by every module that writes a report over a
+ * serial port.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+
+/* Demo application includes. */
+#include "strfmt.h"
+
+/*-----------------------------------------------------------*/
+
+char *pcStrFmtAppendString( char *pcBuffer, const char *pcString )
+{
+	while( *pcString != '\0' )
+	{
+		*pcBuffer = *pcString;
+		pcBuffer++;
+		pcString++;
+	}
+
+	*pcBuffer = '\0';
+	return pcBuffer;
+}
+/*-----------------------------------------------------------*/
+
+char *pcStrFmtAppendNumber( char *pcBuffer, unsigned long ulValue )
+{
+char cDigits[ strfmtMAX_DIGITS ];
+unsigned portBASE_TYPE uxCount = 0;
+
+	do
+	{
+		cDigits[ uxCount ] = ( char ) ( '0' + ( ulValue % 10UL ) );
+		ulValue /= 10UL;
+		uxCount++;
+	} while( ulValue != 0UL );
+
+	while( uxCount > 0 )
+	{
+		uxCount--;
+		*pcBuffer = cDigits[ uxCount ];
+		pcBuffer++;
+	}
+
+	*pcBuffer = '\0';
+	return pcBuffer;
+}
+/*-----------------------------------------------------------*/
+
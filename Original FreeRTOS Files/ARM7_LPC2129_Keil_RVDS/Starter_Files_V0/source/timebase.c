@@ -0,0 +1,144 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Free running Timer1, used as a cycle counter by anything that needs to time
+ * code shorter than a tick, and counted on in microseconds for the kernel's
+ * run-time statistics.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+
+/* Demo application includes. */
+#include "lpc21xx.h"
+#include "timebase.h"
+
+#define timTIMER1_BASE				( ( unsigned long ) 0xE0008000 )
+
+/* Register offsets. */
+#define timIR						( ( unsigned long ) 0x00 )
+#define timTCR						( ( unsigned long ) 0x04 )
+#define timTC						( ( unsigned long ) 0x08 )
+#define timPR						( ( unsigned long ) 0x0C )
+#define timMCR						( ( unsigned long ) 0x14 )
+#define timMR0						( ( unsigned long ) 0x18 )
+
+#define timTCR_ENABLE				( ( unsigned long ) 0x01 )
+#define timTCR_RESET				( ( unsigned long ) 0x02 )
+#define timIR_MR0					( ( unsigned long ) 0x01 )
+#define timMCR_MR0_INTERRUPT		( ( unsigned long ) 0x01 )
+
+/* Register access.  The host build supplies its own, see serial.c. */
+#ifndef timREAD
+	#define timREAD( ulBase, ulOffset )				( *( ( volatile unsigned long * ) ( ( ulBase ) + ( ulOffset ) ) ) )
+	#define timWRITE( ulBase, ulOffset, ulValue )	( timREAD( ( ulBase ), ( ulOffset ) ) = ( ulValue ) )
+#endif
+
+#ifndef timebaseNOW
+	#define timebaseNOW()			timREAD( timTIMER1_BASE, timTC )
+#endif
+
+/* Masks IRQs if they are not masked already and says whether they were, so 
+the context switch, which runs with them masked, and tasks can both call 
+ulTimebaseMicros(). */
+#ifndef timebaseMICROS
+	#define timebaseMASK()				__disable_irq()
+	#define timebaseUNMASK( iWasMasked )	if( ( iWasMasked ) == 0 ) { __enable_irq(); }
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The Timer1 count ulMicros has been brought up to. */
+static unsigned long ulMicrosCount = 0;
+static unsigned long ulMicros = 0;
+
+/*-----------------------------------------------------------*/
+
+void vTimebaseInit( void )
+{
+	/* Hold the count at zero while setting up.  No prescaling, and no match
+	does anything until an alarm is set. */
+	timWRITE( timTIMER1_BASE, timTCR, timTCR_RESET );
+	timWRITE( timTIMER1_BASE, timPR, 0UL );
+	timWRITE( timTIMER1_BASE, timMCR, 0UL );
+	timWRITE( timTIMER1_BASE, timIR, 0xFFUL );
+	ulMicrosCount = 0UL;
+	ulMicros = 0UL;
+	timWRITE( timTIMER1_BASE, timTCR, timTCR_ENABLE );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulTimebaseNow( void )
+{
+	return timebaseNOW();
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulTimebaseMicros( void )
+{
+#ifdef timebaseMICROS
+	return timebaseMICROS();
+#else
+unsigned long ulWhole;
+int iWasMasked;
+
+	iWasMasked = timebaseMASK();
+	{
+		/* Only whole microseconds are taken, the remainder is left for the
+		next call. */
+		ulWhole = ( timebaseNOW() - ulMicrosCount ) / timebaseCOUNTS_PER_US;
+		ulMicrosCount += ulWhole * timebaseCOUNTS_PER_US;
+		ulMicros += ulWhole;
+	}
+	timebaseUNMASK( iWasMasked );
+
+	return ulMicros;
+#endif
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulTimebaseSetAlarm( unsigned long ulDelay )
+{
+unsigned long ulWhen;
+
+	/* Always Timer1's own count, which is what MR0 is compared against. */
+	ulWhen = timREAD( timTIMER1_BASE, timTC ) + ulDelay;
+	timWRITE( timTIMER1_BASE, timMR0, ulWhen );
+	timWRITE( timTIMER1_BASE, timMCR, timMCR_MR0_INTERRUPT );
+
+	return ulWhen;
+}
+/*-----------------------------------------------------------*/
+
+void vTimebaseClearAlarm( void )
+{
+	timWRITE( timTIMER1_BASE, timMCR, 0UL );
+	timWRITE( timTIMER1_BASE, timIR, timIR_MR0 );
+}
+/*-----------------------------------------------------------*/
+
@@ -68,12 +68,29 @@ Stack_Size   	EQU     (UND_Stack_Size + SVC_Stack_Size + ABT_Stack_Size + \
                          FIQ_Stack_Size + IRQ_Stack_Size + USR_Stack_Size )
 
                 AREA    STACK, NOINIT, READWRITE, ALIGN=3
+                EXPORT  Stack_Mem
 Stack_Mem       SPACE   Stack_Size
 
 ;__initial_sp    SPACE   ISR_Stack_Size
 
 Stack_Top		EQU  Stack_Mem + Stack_Size
 
+; Written over every mode stack at reset, so stackmon.c can tell how deep
+; each has been.  The same value the kernel fills task stacks with.
+Stack_Paint     EQU     0xA5A5A5A5
+
+; The size of each mode stack, from the bottom of Stack_Mem up, for 
+; stackmon.c.
+                AREA    |.constdata|, DATA, READONLY, ALIGN=2
+                EXPORT  ulStartupStackSizes
+ulStartupStackSizes
+                DCD     USR_Stack_Size
+                DCD     SVC_Stack_Size
+                DCD     IRQ_Stack_Size
+                DCD     FIQ_Stack_Size
+                DCD     ABT_Stack_Size
+                DCD     UND_Stack_Size
+
 
 ;// <h> Heap Configuration
 ;//   <o>  Heap Size (in Bytes) <0x0-0xFFFFFFFF>
@@ -369,6 +386,16 @@ MEMMAP          EQU     0xE01FC040      ; Memory Mapping Control
 ;  ...
 
 
+; Paint the stacks, nothing is on any of them yet
+
+                LDR     R0, =Stack_Mem
+                LDR     R1, =Stack_Top
+                LDR     R2, =Stack_Paint
+Paint_Loop      CMP     R0, R1
+                STRLO   R2, [R0], #4
+                BLO     Paint_Loop
+
+
 ; Setup Stack for each mode
 
                 LDR     R0, =Stack_Top
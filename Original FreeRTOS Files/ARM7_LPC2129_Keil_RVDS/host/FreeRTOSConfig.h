@@ -0,0 +1,56 @@
+/*
+ * FreeRTOSConfig.h for the host build.
+ *
+ * Pulls in the configuration of the application being built, named by 
+ * hostTARGET_CONFIG on the compiler command line, so the host runs with the
+ * same tick rate, priorities and scheduling policy as the board.  Only what 
+ * the POSIX port and the simulator need is changed below.
+ */
+
+#ifndef HOST_FREERTOS_CONFIG_H
+#define HOST_FREERTOS_CONFIG_H
+
+#ifndef hostTARGET_CONFIG
+	#error Define hostTARGET_CONFIG as the quoted path of the FreeRTOSConfig.h of the application.
+#endif
+
+#include hostTARGET_CONFIG
+
+/* Move the simulated peripherals on at every tick.  This runs inside the 
+tick interrupt, before the kernel decides whether to switch task, which leaves
+vApplicationTickHook() to the applications. */
+#define traceTASK_INCREMENT_TICK( xTickCount )		vSimTick( ( unsigned long ) ( xTickCount ) + 1UL )
+
+/* The simulated ISRs run inside the tick, and any FromISR call that wakes a
+higher priority task leaves a yield pending that the tick acts on as it 
+returns.  The switch the target's ISRs request themselves is not needed. */
+#define portEXIT_SWITCHING_ISR( xSwitchRequired )	( void ) ( xSwitchRequired )
+
+/* The simulator takes the idle hook to skip over idle time, see vSimIdle()
+in include/lpc21xx.h.  An application with its own hook calls vSimIdle(). */
+#if ( configUSE_IDLE_HOOK == 0 )
+	#undef configUSE_IDLE_HOOK
+	#define configUSE_IDLE_HOOK						1
+	#define hostSIM_IDLE_HOOK						1
+#else
+	#define hostSIM_IDLE_HOOK						0
+#endif
+
+/* The POSIX port cannot stop its tick, and the simulator skips idle time by
+itself. */
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE						0
+#undef portSUPPRESS_TICKS_AND_SLEEP
+
+/* Stop a run at the first failed assertion. */
+void vSimAssert( const char *pcFile, int iLine );
+#undef configASSERT
+#define configASSERT( x )							if( ( x ) == 0 ) vSimAssert( __FILE__, __LINE__ )
+
+/* Apart from the heap benchmark, whose heap is the pool heap or heap_2.c, the
+applications allocate nothing at run time, here as on the target.  The
+kernels the host is built against pass the idle task's stack size back as a
+configSTACK_DEPTH_TYPE, which the target's kernel has as a uint32_t. */
+#define configSTACK_DEPTH_TYPE						uint32_t
+
+#endif /* HOST_FREERTOS_CONFIG_H */
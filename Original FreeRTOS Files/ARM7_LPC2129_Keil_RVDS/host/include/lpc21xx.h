@@ -0,0 +1,155 @@
+/*
+ * Simulated LPC21xx register file for the host build.
+ *
+ * Stands in for the Keil lpc21xx.h so the Starter drivers and the assignment
+ * applications compile unchanged against the FreeRTOS POSIX port.  The model
+ * behind these names lives in sim/lpc21xx_sim.c.
+ *
+ * Registers without side effects (PINSEL, VPBDIV, the VIC) are plain 
+ * variables.  The GPIO registers are reached through pulSimGPIO(), which 
+ * first commits whatever was written to IOSET/IOCLR/IOPIN since the previous
+ * access, so a pin written by one statement reads back correctly in the next.
+ * UART and timer registers have read and write side effects (popping the Rx
+ * FIFO, clearing interrupts, a counter that moves with simulated time), so 
+ * they are only reachable through function calls; serial.c, timebase.c and
+ * eint.c use the serREAD()/serWRITE(), timREAD()/timWRITE() and 
+ * eintREAD()/eintWRITE() hooks defined below, and pwm.c pwmREAD()/pwmWRITE().
+ */
+
+#ifndef LPC21XX_SIM_H
+#define LPC21XX_SIM_H
+
+/*-----------------------------------------------------------*/
+
+/* Pin connect block and VPB divider. */
+extern volatile unsigned long ulSimPINSEL0;
+extern volatile unsigned long ulSimPINSEL1;
+extern volatile unsigned long ulSimVPBDIV;
+
+#define PINSEL0				ulSimPINSEL0
+#define PINSEL1				ulSimPINSEL1
+#define VPBDIV				ulSimVPBDIV
+
+/*-----------------------------------------------------------*/
+
+/* GPIO. */
+enum
+{
+	simIOPIN0, simIOSET0, simIODIR0, simIOCLR0,
+	simIOPIN1, simIOSET1, simIODIR1, simIOCLR1
+};
+
+volatile unsigned long *pulSimGPIO( int iRegister );
+
+#define IOPIN0				( *pulSimGPIO( simIOPIN0 ) )
+#define IOSET0				( *pulSimGPIO( simIOSET0 ) )
+#define IODIR0				( *pulSimGPIO( simIODIR0 ) )
+#define IOCLR0				( *pulSimGPIO( simIOCLR0 ) )
+#define IOPIN1				( *pulSimGPIO( simIOPIN1 ) )
+#define IOSET1				( *pulSimGPIO( simIOSET1 ) )
+#define IODIR1				( *pulSimGPIO( simIODIR1 ) )
+#define IOCLR1				( *pulSimGPIO( simIOCLR1 ) )
+
+/*-----------------------------------------------------------*/
+
+/* Vectored interrupt controller.  The vector address and control registers
+are arrays so ( &VICVectAddr0 )[ n ] works as it does on the target.  Vector 
+addresses hold host function pointers, so they are unsigned long to match the
+target code's casts on an LP64 host. */
+extern volatile unsigned long ulSimVICIntSelect;
+extern volatile unsigned long ulSimVICIntEnable;
+extern volatile unsigned long ulSimVICIntEnClr;
+extern volatile unsigned long ulSimVICVectAddr;
+extern volatile unsigned long ulSimVICVectAddrN[ 16 ];
+extern volatile unsigned long ulSimVICVectCntlN[ 16 ];
+
+#define VICIntSelect		ulSimVICIntSelect
+#define VICIntEnable		ulSimVICIntEnable
+#define VICIntEnClr			ulSimVICIntEnClr
+#define VICVectAddr			ulSimVICVectAddr
+#define VICVectAddr0		( ulSimVICVectAddrN[ 0 ] )
+#define VICVectAddr1		( ulSimVICVectAddrN[ 1 ] )
+#define VICVectAddr2		( ulSimVICVectAddrN[ 2 ] )
+#define VICVectAddr3		( ulSimVICVectAddrN[ 3 ] )
+#define VICVectCntl0		( ulSimVICVectCntlN[ 0 ] )
+#define VICVectCntl1		( ulSimVICVectCntlN[ 1 ] )
+#define VICVectCntl2		( ulSimVICVectCntlN[ 2 ] )
+#define VICVectCntl3		( ulSimVICVectCntlN[ 3 ] )
+
+/*-----------------------------------------------------------*/
+
+/* UARTs.  ulBase is 0xE000C000 for UART0 and 0xE0010000 for UART1, the 
+offsets are those of the real register block. */
+unsigned char ucSimUARTRead( unsigned long ulBase, unsigned long ulOffset );
+void vSimUARTWrite( unsigned long ulBase, unsigned long ulOffset, unsigned char ucValue );
+
+#define serREAD( pxPort, ulOffset )				ucSimUARTRead( ( pxPort )->ulBase, ( ulOffset ) )
+#define serWRITE( pxPort, ulOffset, ucValue )	vSimUARTWrite( ( pxPort )->ulBase, ( ulOffset ), ( unsigned char ) ( ucValue ) )
+
+/*-----------------------------------------------------------*/
+
+/* Timers.  ulBase is 0xE0004000 for Timer0 and 0xE0008000 for Timer1, the
+offsets are those of the real register block.  Timer0 is the tick, and is set
+up by the simulator as the port would set it up on the target. */
+unsigned long ulSimTimerRead( unsigned long ulBase, unsigned long ulOffset );
+void vSimTimerWrite( unsigned long ulBase, unsigned long ulOffset, unsigned long ulValue );
+
+#define timREAD( ulBase, ulOffset )				ulSimTimerRead( ( ulBase ), ( ulOffset ) )
+#define timWRITE( ulBase, ulOffset, ulValue )	vSimTimerWrite( ( ulBase ), ( ulOffset ), ( ulValue ) )
+
+/* The simulated Timer1 only moves at ticks, so timebase.c counts with the
+host's monotonic clock instead, scaled to configCPU_CLOCK_HZ, and what it
+times is the host.  The count is as wide as an unsigned long and does not wrap
+on an LP64 host. */
+unsigned long ulSimHostCycles( void );
+
+#define timebaseNOW()							ulSimHostCycles()
+
+/* The same count in microseconds, for the kernel's run-time statistics.  It
+needs no catching up as it does on the target, and the kernel keeps only the
+low 32 bits, which wrap as the target's do. */
+#define timebaseMICROS()						( ulSimHostCycles() / ( configCPU_CLOCK_HZ / 1000000UL ) )
+
+/*-----------------------------------------------------------*/
+
+/* There is no Startup.s, and so no mode stacks for stackmon.c to scan. */
+#define stackmonMODE_STACKS						0
+
+/* binlog.c's compiler barrier, __memory_changed() under armcc. */
+#define binlogBARRIER()							__asm volatile( "" ::: "memory" )
+
+/*-----------------------------------------------------------*/
+
+/* External interrupts.  Offsets are from the system control block, 
+0xE01FC000.  The lines follow the port 0 input pins PINSEL0 and PINSEL1 route
+to them. */
+unsigned long ulSimEINTRead( unsigned long ulOffset );
+void vSimEINTWrite( unsigned long ulOffset, unsigned long ulValue );
+
+#define eintREAD( ulOffset )					ulSimEINTRead( ulOffset )
+#define eintWRITE( ulOffset, ulValue )			vSimEINTWrite( ( ulOffset ), ( ulValue ) )
+
+/*-----------------------------------------------------------*/
+
+/* PWM.  Offsets are from 0xE0014000.  The count is only looked at when a 
+register is accessed and at each tick, so an output pin changes level at a 
+tick. */
+unsigned long ulSimPWMRead( unsigned long ulOffset );
+void vSimPWMWrite( unsigned long ulOffset, unsigned long ulValue );
+
+#define pwmREAD( ulOffset )						ulSimPWMRead( ulOffset )
+#define pwmWRITE( ulOffset, ulValue )			vSimPWMWrite( ( ulOffset ), ( ulValue ) )
+
+/*-----------------------------------------------------------*/
+
+/* Called from the kernel's tick through traceTASK_INCREMENT_TICK() to move 
+the simulation on by one tick and deliver any pending interrupts. */
+void vSimTick( unsigned long ulTickCount );
+
+/* Called from the idle task.  When the simulation runs as fast as it can, 
+takes the next tick straight away as nothing can happen before it.  The 
+simulator calls it from its own vApplicationIdleHook(), an application that
+has an idle hook of its own should call it from there. */
+void vSimIdle( void );
+
+#endif /* LPC21XX_SIM_H */
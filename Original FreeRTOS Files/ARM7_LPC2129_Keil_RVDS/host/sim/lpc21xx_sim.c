@@ -0,0 +1,1819 @@
+/*
+ * Peripheral model behind include/lpc21xx.h for the host build.
+ *
+ * A discrete event simulation on the virtual clock of sim_clock.c, which 
+ * counts processor cycles.  The UARTs schedule an event for the cycle each
+ * character finishes on the line, from the divisor latch, the line control
+ * register and VPBDIV, and the timers one for their next match.  The handler
+ * of every enabled interrupt is called, as the VIC would, as soon as the event
+ * that raised it has run.  The external interrupt lines follow the input
+ * pins they are routed to by PINSEL0 and PINSEL1.  The PWM block drives the
+ * port 0 pins PINSEL1 hands it, with the level its count has reached at the
+ * tick; it raises no interrupts.
+ *
+ * The kernel tick stands for the Timer0 match the port uses on the target.
+ * The simulator starts Timer0 as the port does, and each call of vSimTick() 
+ * from the kernel's tick (see traceTASK_INCREMENT_TICK() in 
+ * ../FreeRTOSConfig.h), with interrupts masked:
+ *
+ *  + runs every event due up to the next Timer0 match, calling the handlers
+ *    of the interrupts they raise,
+ *  + applies any GPIO input changes from the stimulus file that are due.
+ *
+ * Tasks therefore run between ticks at a fixed point in simulated time, and
+ * an interrupt raised by a register write from a task is delivered at the 
+ * next event or tick.  A task woken by a FromISR call runs at the end of the
+ * tick, as the kernel's own switch check picks up the yield the FromISR call
+ * leaves pending.
+ *
+ * Only the tick is paced by the host.  LPC_SIM_SPEED divides the interval of
+ * the POSIX port's tick timer, and "max" also takes the next tick as soon as
+ * the idle task runs, so simulated time jumps over anything the application
+ * spends blocked.  Every input reaches the application at a tick and every
+ * output is stamped with the tick, so the trace of a run does not depend on
+ * the speed as long as each tick's work is done before the next tick.  A 
+ * task that busy waits still runs for as long as the host lets it.
+ *
+ * Configured from the environment:
+ *
+ *  LPC_SIM_UARTn_OUT	file that receives what UARTn transmits.  UART1 goes
+ *						to stdout and UART0 nowhere by default.
+ *  LPC_SIM_UARTn_IN	file whose bytes UARTn receives at the line rate, or -
+ *						for stdin.  Nothing is received by default.
+ *  LPC_SIM_STIMULUS	GPIO input script, one "tick port pin level" change 
+ *						per line in tick order, e.g. "500 0 17 1" drives P0.17
+ *						high at tick 500.  A "repeat ticks" line starts the 
+ *						script again every that many ticks.  Input pins read
+ *						low until driven, changes at tick 0 hold from reset.
+ *  LPC_SIM_TRACE		file that receives one "tick Pp.n level" line per 
+ *						change of an output pin.
+ *  LPC_SIM_TICKS		exit with status 0 after this many ticks, reporting 
+ *						the simulated and elapsed time on stderr.
+ *  LPC_SIM_SPEED		how many times faster than real time to run, or max.
+ *						1 by default.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lpc21xx.h"
+#include "sim_clock.h"
+
+#define simUART0_BASE				( 0xE000C000UL )
+#define simUART1_BASE				( 0xE0010000UL )
+#define simUART0_CHANNEL			( 6UL )
+#define simUART1_CHANNEL			( 7UL )
+#define simNUM_UARTS				( 2 )
+#define simFIFO_LENGTH				( 16 )
+
+/* UART register offsets. */
+#define simRBR						( 0x00 )
+#define simIER						( 0x04 )
+#define simIIR						( 0x08 )
+#define simLCR						( 0x0C )
+#define simLSR						( 0x14 )
+#define simSCR						( 0x1C )
+
+#define simIER_RDA					( 0x01 )
+#define simIER_THRE					( 0x02 )
+#define simIER_RLS					( 0x04 )
+
+#define simIIR_NONE					( 0x01 )
+#define simIIR_THRE					( 0x02 )
+#define simIIR_RDA					( 0x04 )
+#define simIIR_RLS					( 0x06 )
+#define simIIR_CTI					( 0x0C )
+#define simIIR_FIFOS_ON				( 0xC0 )
+
+#define simLSR_DR					( 0x01 )
+#define simLSR_OE					( 0x02 )
+#define simLSR_THRE					( 0x20 )
+#define simLSR_TEMT					( 0x40 )
+
+#define simFCR_ENABLE				( 0x01 )
+#define simFCR_RX_RESET				( 0x02 )
+#define simFCR_TX_RESET				( 0x04 )
+
+#define simLCR_WORD_LENGTH			( 0x03 )
+#define simLCR_STOP_2				( 0x04 )
+#define simLCR_PARITY				( 0x08 )
+#define simLCR_DLAB					( 0x80 )
+
+/* The character timeout fires after between 3.5 and 4.5 character times
+without a character arriving or being read on the target. */
+#define simCTI_CHARS				( 4ULL )
+
+#define simTIMER0_BASE				( 0xE0004000UL )
+#define simTIMER1_BASE				( 0xE0008000UL )
+#define simTIMER0_CHANNEL			( 4UL )
+#define simTIMER1_CHANNEL			( 5UL )
+#define simNUM_TIMERS				( 2 )
+#define simNUM_MATCH				( 4 )
+
+/* Timer register offsets.  Match register n is at simTxMR0 + 4n. */
+#define simTxIR						( 0x00 )
+#define simTxTCR					( 0x04 )
+#define simTxTC						( 0x08 )
+#define simTxPR						( 0x0C )
+#define simTxPC						( 0x10 )
+#define simTxMCR					( 0x14 )
+#define simTxMR0					( 0x18 )
+
+#define simIR_MR0					( 0x01UL )
+#define simIR_MATCH					( 0x0FUL )
+#define simTCR_ENABLE				( 0x01UL )
+#define simTCR_RESET				( 0x02UL )
+
+/* Match control, three bits per match register. */
+#define simMCR_INTERRUPT			( 0x01UL )
+#define simMCR_RESET				( 0x02UL )
+#define simMCR_STOP					( 0x04UL )
+#define simMCR_ACTIONS				( 0x07UL )
+#define simMCR_ALL					( 0x0FFFUL )
+
+#define simTIMER_MASK				( 0xFFFFFFFFUL )
+
+/* External interrupts, offsets from the system control block. */
+#define simEXTINT					( 0x140 )
+#define simEXTWAKE					( 0x144 )
+#define simEXTMODE					( 0x148 )
+#define simEXTPOLAR					( 0x14C )
+#define simEINT_CHANNEL				( 14UL )		/* EINT0, the others follow. */
+#define simNUM_EINTS				( 4 )
+#define simEINT_MASK				( 0x0FUL )
+
+/* PWM register offsets, from 0xE0014000.  MR4 to MR6 are not after MR3. */
+#define simPWMIR					( 0x00 )
+#define simPWMTCR					( 0x04 )
+#define simPWMTC					( 0x08 )
+#define simPWMPR					( 0x0C )
+#define simPWMMCR					( 0x14 )
+#define simPWMMR0					( 0x18 )
+#define simPWMMR4					( 0x40 )
+#define simPWMPCR					( 0x4C )
+#define simPWMLER					( 0x50 )
+#define simNUM_PWM_MATCH			( 7 )
+
+#define simPWMTCR_PWM_ENABLE		( 0x08UL )
+
+#define simVIC_SLOT_ENABLE			( 0x20UL )
+#define simNUM_VIC_SLOTS			( 16 )
+
+/* Processor cycles between ticks with the peripheral clock at full speed,
+which is what Timer0 is set up for. */
+#define simCYCLES_PER_TICK			( ( xSimTime ) configCPU_CLOCK_HZ / ( xSimTime ) configTICK_RATE_HZ )
+
+/* Bounds the number of times a handler is re-entered after one event, in
+case it leaves its interrupt pending. */
+#define simMAX_DISPATCHES			( 8 )
+
+#define simMAX_STIMULI				( 1024 )
+
+/* The shortest tick interval asked of the host when running flat out. */
+#define simFASTEST_TICK_US			( 10UL )
+
+/*-----------------------------------------------------------*/
+
+typedef struct SIM_UART
+{
+	unsigned long ulBase;
+	unsigned long ulChannel;
+	unsigned char ucIER, ucLCR, ucFCR, ucDLL, ucDLM, ucSCR, ucErrors;
+	unsigned char ucRxFifo[ simFIFO_LENGTH ];
+	int iRxHead, iRxCount;
+	unsigned char ucTxFifo[ simFIFO_LENGTH ];
+	int iTxHead, iTxCount;
+	unsigned char ucShift;			/* The character on its way out. */
+	int iShifting;
+	int iTHREPending;
+	xSimTime xRxActivity;			/* When a character was last received or read. */
+	xSimEvent xTxDone;				/* ucShift has gone out. */
+	xSimEvent xRxNext;				/* The next character has come in. */
+	xSimEvent xRxTimeout;			/* The character timeout is due. */
+	int iOutFd, iInFd;
+} xSimUART;
+
+typedef struct SIM_TIMER
+{
+	unsigned long ulBase;
+	unsigned long ulChannel;
+	unsigned long ulIR, ulTCR, ulPR, ulMCR;
+	unsigned long ulMR[ simNUM_MATCH ];
+	unsigned long ulTC;				/* The count at xStart. */
+	xSimTime xStart;
+	xSimEvent xMatch;				/* The nearest match with anything to do. */
+} xSimTimer;
+
+/* A port 0 pin that can carry an external interrupt line, and the PINSEL 
+field value that routes it there. */
+typedef struct SIM_EINT_PIN
+{
+	int iPin;
+	volatile unsigned long *pulPINSEL;
+	unsigned long ulShift;
+	unsigned long ulFunction;
+	unsigned long ulLine;
+} xSimEintPin;
+
+/* Only MR0 resetting the count is modelled, with single edge outputs.  
+ulMR holds the match values in use and ulShadow those written since, which
+LER lets through when the count next resets. */
+typedef struct SIM_PWM
+{
+	unsigned long ulTCR, ulPR, ulMCR, ulPCR, ulLER;
+	unsigned long ulMR[ simNUM_PWM_MATCH ];
+	unsigned long ulShadow[ simNUM_PWM_MATCH ];
+	unsigned long ulTC;				/* The count at xStart. */
+	xSimTime xStart;
+} xSimPWM;
+
+/* A port 0 pin with a PWM output and its PINSEL1 field. */
+typedef struct SIM_PWM_PIN
+{
+	int iPin;
+	unsigned long ulShift;
+	unsigned long ulChannel;
+} xSimPWMPin;
+
+typedef struct SIM_STIMULUS
+{
+	unsigned long ulTick;
+	int iPort;
+	int iPin;
+	int iLevel;
+} xSimStimulus;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The asm wrappers on the target.  Here the VIC calls them directly.
+ */
+void vUART0_ISREntry( void );
+void vUART_ISREntry( void );
+void vKernelBench_ISREntry( void );
+void vEint_ISREntry( void );
+extern void vUART_ISRHandler( void );
+
+/* Only the applications that use them have these.  The serial engine bench
+links the demo's UART1 driver in place of the Starter one, so has no UART0. */
+extern void vUART0_ISRHandler( void ) __attribute__( ( weak ) );
+extern void vKernelBench_ISRHandler( void ) __attribute__( ( weak ) );
+extern void vEint_ISRHandler( void ) __attribute__( ( weak ) );
+
+/*
+ * The POSIX port's tick timer, see the --wrap option in ../Makefile.
+ */
+int __real_setitimer( int iWhich, const struct itimerval *pxNew, struct itimerval *pxOld );
+int __wrap_setitimer( int iWhich, const struct itimerval *pxNew, struct itimerval *pxOld );
+
+static void prvSimInit( void ) __attribute__( ( constructor ) );
+static void prvCommitGPIO( void );
+static void prvTraceWrite( const char *pcText );
+static unsigned long prvPCLKDivider( void );
+static xSimUART *prvFindUART( unsigned long ulBase );
+static xSimTime prvUARTCharCycles( xSimUART *pxUART );
+static void prvUARTTxStart( xSimUART *pxUART );
+static void prvUARTTxDone( xSimEvent *pxEvent );
+static void prvUARTRxNext( xSimEvent *pxEvent );
+static void prvUARTRxTimeout( xSimEvent *pxEvent );
+static unsigned char prvUARTSource( xSimUART *pxUART );
+static xSimTimer *prvFindTimer( unsigned long ulBase );
+static int prvTimerRunning( xSimTimer *pxTimer );
+static xSimTime prvTimerCycles( xSimTimer *pxTimer );
+static void prvTimerSync( xSimTimer *pxTimer );
+static void prvTimerSchedule( xSimTimer *pxTimer );
+static void prvTimerMatch( xSimEvent *pxEvent );
+static unsigned long prvEintLevels( unsigned long *pulRouted );
+static long prvPWMOffsetToMatch( unsigned long ulOffset );
+static void prvPWMSync( void );
+static unsigned long prvPWMLevels( unsigned long *pulDriven );
+static void prvEintSample( void );
+static void prvStartTickTimer( void );
+static int prvRaiseIRQ( unsigned long ulChannel );
+static void prvDispatch( void );
+static void prvApplyStimuli( void );
+static void prvScaleInterval( struct timeval *pxInterval );
+static void prvReport( void );
+static int prvOpenOutput( const char *pcVariable, int iDefault );
+static int prvOpenInput( const char *pcVariable );
+static void prvLoadStimuli( const char *pcPath );
+
+/*-----------------------------------------------------------*/
+
+volatile unsigned long ulSimPINSEL0 = 0;
+volatile unsigned long ulSimPINSEL1 = 0;
+volatile unsigned long ulSimVPBDIV = 0;
+
+volatile unsigned long ulSimVICIntSelect = 0;
+volatile unsigned long ulSimVICIntEnable = 0;
+volatile unsigned long ulSimVICIntEnClr = 0;
+volatile unsigned long ulSimVICVectAddr = 0;
+volatile unsigned long ulSimVICVectAddrN[ simNUM_VIC_SLOTS ];
+volatile unsigned long ulSimVICVectCntlN[ simNUM_VIC_SLOTS ];
+
+/* IOPIN, IOSET, IODIR, IOCLR for port 0 then port 1, in the order of the
+simIOxxx enum. */
+static volatile unsigned long ulGPIO[ 8 ];
+static unsigned long ulLatch[ 2 ];
+static unsigned long ulInputs[ 2 ];
+static unsigned long ulPublished[ 2 ];		/* IOPIN as last written by the model. */
+static unsigned long ulTraced[ 2 ];
+
+static xSimUART xUARTs[ simNUM_UARTS ] =
+{
+	{ simUART0_BASE, simUART0_CHANNEL },
+	{ simUART1_BASE, simUART1_CHANNEL }
+};
+
+static xSimTimer xTimers[ simNUM_TIMERS ] =
+{
+	{ simTIMER0_BASE, simTIMER0_CHANNEL },
+	{ simTIMER1_BASE, simTIMER1_CHANNEL }
+};
+
+static const xSimEintPin xEintPins[] =
+{
+	{ 1, &ulSimPINSEL0, 2, 3, 0 },	{ 16, &ulSimPINSEL1, 0, 1, 0 },
+	{ 3, &ulSimPINSEL0, 6, 3, 1 },	{ 14, &ulSimPINSEL0, 28, 2, 1 },
+	{ 7, &ulSimPINSEL0, 14, 3, 2 },	{ 15, &ulSimPINSEL0, 30, 2, 2 },
+	{ 9, &ulSimPINSEL0, 18, 3, 3 },	{ 20, &ulSimPINSEL1, 8, 3, 3 },	{ 30, &ulSimPINSEL1, 28, 2, 3 }
+};
+
+/* PWM1 to PWM4 and PWM6 are on P0.0 to P0.9, PINSEL0. */
+static const xSimPWMPin xPWMPins[] =
+{
+	{ 21, 10, 5 }
+};
+
+static xSimPWM xPWM;
+
+static unsigned long ulEXTINT = 0, ulEXTWAKE = 0, ulEXTMODE = 0, ulEXTPOLAR = 0;
+static unsigned long ulEintLevels = 0;		/* The lines as last sampled. */
+
+static xSimStimulus xStimuli[ simMAX_STIMULI ];
+static int iNumStimuli = 0, iNextStimulus = 0;
+static unsigned long ulRepeatTicks = 0;		/* 0 to run the script once. */
+static unsigned long ulScriptStart = 0;		/* The tick the script's ticks count from. */
+
+static unsigned long ulTick = 0;
+static unsigned long ulStopTick = 0;
+static int iTickStarted = 0;
+static int iTraceFd = -1;
+
+/* How many times faster than real time to run, 0 for as fast as possible. */
+static unsigned long ulSpeed = 1;
+static struct timespec xStarted;
+
+/*-----------------------------------------------------------*/
+
+void vUART0_ISREntry( void )
+{
+	vUART0_ISRHandler();
+}
+/*-----------------------------------------------------------*/
+
+void vUART_ISREntry( void )
+{
+	vUART_ISRHandler();
+}
+/*-----------------------------------------------------------*/
+
+void vKernelBench_ISREntry( void )
+{
+	vKernelBench_ISRHandler();
+}
+/*-----------------------------------------------------------*/
+
+void vEint_ISREntry( void )
+{
+	vEint_ISRHandler();
+}
+/*-----------------------------------------------------------*/
+
+void vSimAssert( const char *pcFile, int iLine )
+{
+	fprintf( stderr, "lpc21xx_sim: assertion failed at %s:%d, tick %lu\n", pcFile, iLine, ulTick );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimInit( void )
+{
+const char *pcValue;
+char *pcEnd;
+int iIndex;
+
+	clock_gettime( CLOCK_MONOTONIC, &xStarted );
+
+	xUARTs[ 0 ].iOutFd = prvOpenOutput( "LPC_SIM_UART0_OUT", -1 );
+	xUARTs[ 1 ].iOutFd = prvOpenOutput( "LPC_SIM_UART1_OUT", STDOUT_FILENO );
+	xUARTs[ 0 ].iInFd = prvOpenInput( "LPC_SIM_UART0_IN" );
+	xUARTs[ 1 ].iInFd = prvOpenInput( "LPC_SIM_UART1_IN" );
+	iTraceFd = prvOpenOutput( "LPC_SIM_TRACE", -1 );
+
+	for( iIndex = 0; iIndex < simNUM_UARTS; iIndex++ )
+	{
+		vSimEventInit( &xUARTs[ iIndex ].xTxDone, prvUARTTxDone, &xUARTs[ iIndex ] );
+		vSimEventInit( &xUARTs[ iIndex ].xRxNext, prvUARTRxNext, &xUARTs[ iIndex ] );
+		vSimEventInit( &xUARTs[ iIndex ].xRxTimeout, prvUARTRxTimeout, &xUARTs[ iIndex ] );
+
+		if( xUARTs[ iIndex ].iInFd >= 0 )
+		{
+			vSimEventSchedule( &xUARTs[ iIndex ].xRxNext, 0 );
+		}
+	}
+
+	for( iIndex = 0; iIndex < simNUM_TIMERS; iIndex++ )
+	{
+		vSimEventInit( &xTimers[ iIndex ].xMatch, prvTimerMatch, &xTimers[ iIndex ] );
+	}
+
+	pcValue = getenv( "LPC_SIM_STIMULUS" );
+	if( pcValue != NULL )
+	{
+		/* Tick 0 is the state of the inputs out of reset, so an edge 
+		interrupt does not see them being driven there. */
+		prvLoadStimuli( pcValue );
+		prvApplyStimuli();
+	}
+
+	pcValue = getenv( "LPC_SIM_TICKS" );
+	if( pcValue != NULL )
+	{
+		ulStopTick = strtoul( pcValue, NULL, 0 );
+	}
+
+	pcValue = getenv( "LPC_SIM_SPEED" );
+	if( pcValue != NULL )
+	{
+		if( strcmp( pcValue, "max" ) == 0 )
+		{
+			ulSpeed = 0;
+		}
+		else
+		{
+			ulSpeed = strtoul( pcValue, &pcEnd, 0 );
+
+			if( ( *pcEnd != '\0' ) || ( ulSpeed == 0UL ) )
+			{
+				fprintf( stderr, "lpc21xx_sim: LPC_SIM_SPEED=%s is neither a whole number from 1 nor max\n", pcValue );
+				exit( EXIT_FAILURE );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvOpenOutput( const char *pcVariable, int iDefault )
+{
+const char *pcPath = getenv( pcVariable );
+int iFd;
+
+	if( pcPath == NULL )
+	{
+		return iDefault;
+	}
+
+	iFd = open( pcPath, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+	if( iFd < 0 )
+	{
+		fprintf( stderr, "lpc21xx_sim: cannot open %s=%s: %s\n", pcVariable, pcPath, strerror( errno ) );
+		exit( EXIT_FAILURE );
+	}
+
+	return iFd;
+}
+/*-----------------------------------------------------------*/
+
+static int prvOpenInput( const char *pcVariable )
+{
+const char *pcPath = getenv( pcVariable );
+int iFd;
+
+	if( pcPath == NULL )
+	{
+		return -1;
+	}
+
+	if( strcmp( pcPath, "-" ) == 0 )
+	{
+		iFd = STDIN_FILENO;
+	}
+	else
+	{
+		iFd = open( pcPath, O_RDONLY );
+		if( iFd < 0 )
+		{
+			fprintf( stderr, "lpc21xx_sim: cannot open %s=%s: %s\n", pcVariable, pcPath, strerror( errno ) );
+			exit( EXIT_FAILURE );
+		}
+	}
+
+	/* Bytes are pulled from the tick, which must never block. */
+	fcntl( iFd, F_SETFL, fcntl( iFd, F_GETFL ) | O_NONBLOCK );
+
+	return iFd;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadStimuli( const char *pcPath )
+{
+FILE *pxFile;
+char cLine[ 128 ];
+xSimStimulus *pxStimulus;
+
+	pxFile = fopen( pcPath, "r" );
+	if( pxFile == NULL )
+	{
+		fprintf( stderr, "lpc21xx_sim: cannot open LPC_SIM_STIMULUS=%s: %s\n", pcPath, strerror( errno ) );
+		exit( EXIT_FAILURE );
+	}
+
+	while( ( fgets( cLine, sizeof( cLine ), pxFile ) != NULL ) && ( iNumStimuli < simMAX_STIMULI ) )
+	{
+		pxStimulus = &xStimuli[ iNumStimuli ];
+
+		if( ( cLine[ 0 ] == '#' ) || ( sscanf( cLine, "repeat %lu", &ulRepeatTicks ) == 1 ) )
+		{
+			continue;
+		}
+
+		if( sscanf( cLine, "%lu %d %d %d", &pxStimulus->ulTick, &pxStimulus->iPort, &pxStimulus->iPin, &pxStimulus->iLevel ) != 4 )
+		{
+			continue;
+		}
+
+		if( ( pxStimulus->iPort < 0 ) || ( pxStimulus->iPort > 1 ) || ( pxStimulus->iPin < 0 ) || ( pxStimulus->iPin > 31 ) )
+		{
+			fprintf( stderr, "lpc21xx_sim: bad stimulus: %s", cLine );
+			exit( EXIT_FAILURE );
+		}
+
+		iNumStimuli++;
+	}
+
+	fclose( pxFile );
+
+	/* Each pass must be over before the next one starts. */
+	if( ( ulRepeatTicks != 0UL ) && ( iNumStimuli > 0 ) && ( xStimuli[ iNumStimuli - 1 ].ulTick >= ulRepeatTicks ) )
+	{
+		fprintf( stderr, "lpc21xx_sim: stimulus at tick %lu is not inside repeat %lu\n", xStimuli[ iNumStimuli - 1 ].ulTick, ulRepeatTicks );
+		exit( EXIT_FAILURE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimGPIO( int iRegister )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	/* Also called from the tick, so the mask is saved rather than nested. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvCommitGPIO();
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return &ulGPIO[ iRegister ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommitGPIO( void )
+{
+int iPort;
+volatile unsigned long *pulRegisters;
+unsigned long ulPins, ulChanged, ulBit, ulPWMPins, ulPWMDriven, ulOutputs;
+char cLine[ 48 ];
+
+	ulPWMPins = prvPWMLevels( &ulPWMDriven );
+
+	for( iPort = 0; iPort < 2; iPort++ )
+	{
+		pulRegisters = &ulGPIO[ iPort * 4 ];
+
+		/* A write to IOPIN itself loads the output latch. */
+		if( pulRegisters[ simIOPIN0 ] != ulPublished[ iPort ] )
+		{
+			ulLatch[ iPort ] = pulRegisters[ simIOPIN0 ];
+		}
+
+		ulLatch[ iPort ] |= pulRegisters[ simIOSET0 ];
+		ulLatch[ iPort ] &= ~pulRegisters[ simIOCLR0 ];
+		pulRegisters[ simIOSET0 ] = 0;
+		pulRegisters[ simIOCLR0 ] = 0;
+
+		ulPins = ( ulLatch[ iPort ] & pulRegisters[ simIODIR0 ] ) | ( ulInputs[ iPort ] & ~pulRegisters[ simIODIR0 ] );
+		ulOutputs = pulRegisters[ simIODIR0 ];
+
+		/* A pin given to the PWM block follows it whatever IODIR says. */
+		if( iPort == 0 )
+		{
+			ulPins = ( ulPins & ~ulPWMDriven ) | ulPWMPins;
+			ulOutputs |= ulPWMDriven;
+		}
+
+		pulRegisters[ simIOPIN0 ] = ulPins;
+		ulPublished[ iPort ] = ulPins;
+
+		/* Trace the output pins that changed. */
+		ulChanged = ( ulPins ^ ulTraced[ iPort ] ) & ulOutputs;
+		ulTraced[ iPort ] = ( ulTraced[ iPort ] & ~ulOutputs ) | ( ulPins & ulOutputs );
+
+		for( ulBit = 0; ( ulChanged != 0 ) && ( ulBit < 32 ); ulBit++ )
+		{
+			if( ( ulChanged & ( 1UL << ulBit ) ) != 0 )
+			{
+				snprintf( cLine, sizeof( cLine ), "%lu P%d.%lu %lu\n", ulTick, iPort, ulBit, ( ulPins >> ulBit ) & 1UL );
+				prvTraceWrite( cLine );
+				ulChanged &= ~( 1UL << ulBit );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceWrite( const char *pcText )
+{
+	if( iTraceFd >= 0 )
+	{
+		( void ) write( iTraceFd, pcText, strlen( pcText ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvPCLKDivider( void )
+{
+	/* VPBDIV 1 runs the peripherals at the processor clock, 2 at half of it
+	and 0, the reset value, at a quarter. */
+	return ( unsigned long ) "\x04\x01\x02\x04"[ ulSimVPBDIV & 0x03UL ];
+}
+/*-----------------------------------------------------------*/
+
+static xSimUART *prvFindUART( unsigned long ulBase )
+{
+int iIndex;
+
+	for( iIndex = 0; iIndex < simNUM_UARTS; iIndex++ )
+	{
+		if( xUARTs[ iIndex ].ulBase == ulBase )
+		{
+			return &xUARTs[ iIndex ];
+		}
+	}
+
+	fprintf( stderr, "lpc21xx_sim: no UART at 0x%08lx\n", ulBase );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+unsigned char ucSimUARTRead( unsigned long ulBase, unsigned long ulOffset )
+{
+xSimUART *pxUART = prvFindUART( ulBase );
+unsigned char ucValue = 0;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		switch( ulOffset )
+		{
+			case simRBR :
+				if( ( pxUART->ucLCR & simLCR_DLAB ) != 0 )
+				{
+					ucValue = pxUART->ucDLL;
+				}
+				else if( pxUART->iRxCount > 0 )
+				{
+					ucValue = pxUART->ucRxFifo[ pxUART->iRxHead ];
+					pxUART->iRxHead = ( pxUART->iRxHead + 1 ) % simFIFO_LENGTH;
+					pxUART->iRxCount--;
+
+					/* Reading restarts the character timeout. */
+					pxUART->xRxActivity = xSimNow();
+
+					if( pxUART->iRxCount > 0 )
+					{
+						vSimEventSchedule( &pxUART->xRxTimeout, xSimNow() + ( simCTI_CHARS * prvUARTCharCycles( pxUART ) ) );
+					}
+					else
+					{
+						vSimEventCancel( &pxUART->xRxTimeout );
+					}
+				}
+				break;
+
+			case simIER :
+				ucValue = ( ( pxUART->ucLCR & simLCR_DLAB ) != 0 ) ? pxUART->ucDLM : pxUART->ucIER;
+				break;
+
+			case simIIR :
+				/* Reading the IIR clears a THRE interrupt. */
+				ucValue = prvUARTSource( pxUART );
+
+				if( ucValue == simIIR_THRE )
+				{
+					pxUART->iTHREPending = 0;
+				}
+
+				if( ( pxUART->ucFCR & simFCR_ENABLE ) != 0 )
+				{
+					ucValue |= simIIR_FIFOS_ON;
+				}
+				break;
+
+			case simLCR :
+				ucValue = pxUART->ucLCR;
+				break;
+
+			case simLSR :
+				/* The error bits clear on reading. */
+				ucValue = pxUART->ucErrors;
+				pxUART->ucErrors = 0;
+
+				if( pxUART->iRxCount > 0 )
+				{
+					ucValue |= simLSR_DR;
+				}
+
+				if( pxUART->iTxCount == 0 )
+				{
+					ucValue |= simLSR_THRE;
+
+					if( pxUART->iShifting == 0 )
+					{
+						ucValue |= simLSR_TEMT;
+					}
+				}
+				break;
+
+			case simSCR :
+				ucValue = pxUART->ucSCR;
+				break;
+
+			default :
+				break;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return ucValue;
+}
+/*-----------------------------------------------------------*/
+
+void vSimUARTWrite( unsigned long ulBase, unsigned long ulOffset, unsigned char ucValue )
+{
+xSimUART *pxUART = prvFindUART( ulBase );
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		switch( ulOffset )
+		{
+			case simRBR :	/* THR or DLL. */
+				if( ( pxUART->ucLCR & simLCR_DLAB ) != 0 )
+				{
+					pxUART->ucDLL = ucValue;
+				}
+				else if( pxUART->iTxCount < simFIFO_LENGTH )
+				{
+					pxUART->ucTxFifo[ ( pxUART->iTxHead + pxUART->iTxCount ) % simFIFO_LENGTH ] = ucValue;
+					pxUART->iTxCount++;
+					pxUART->iTHREPending = 0;
+					prvUARTTxStart( pxUART );
+				}
+				break;
+
+			case simIER :	/* IER or DLM. */
+				if( ( pxUART->ucLCR & simLCR_DLAB ) != 0 )
+				{
+					pxUART->ucDLM = ucValue;
+				}
+				else
+				{
+					/* Enabling the THRE interrupt with the THR empty raises
+					it straight away. */
+					if( ( ( pxUART->ucIER & simIER_THRE ) == 0 ) && ( ( ucValue & simIER_THRE ) != 0 ) && ( pxUART->iTxCount == 0 ) )
+					{
+						pxUART->iTHREPending = 1;
+					}
+
+					pxUART->ucIER = ucValue & ( simIER_RDA | simIER_THRE | simIER_RLS );
+				}
+				break;
+
+			case simIIR :	/* FCR. */
+				pxUART->ucFCR = ucValue & ( unsigned char ) ~( simFCR_RX_RESET | simFCR_TX_RESET );
+
+				if( ( ucValue & simFCR_RX_RESET ) != 0 )
+				{
+					pxUART->iRxCount = 0;
+					vSimEventCancel( &pxUART->xRxTimeout );
+				}
+
+				if( ( ucValue & simFCR_TX_RESET ) != 0 )
+				{
+					pxUART->iTxCount = 0;
+				}
+				break;
+
+			case simLCR :
+				pxUART->ucLCR = ucValue;
+
+				/* Anything written before the divisor was set goes out now. */
+				prvUARTTxStart( pxUART );
+				break;
+
+			case simSCR :
+				pxUART->ucSCR = ucValue;
+				break;
+
+			default :
+				break;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static xSimTime prvUARTCharCycles( xSimUART *pxUART )
+{
+unsigned long ulDivisor = ( ( unsigned long ) pxUART->ucDLM << 8 ) | pxUART->ucDLL;
+unsigned long ulBits;
+
+	if( ulDivisor == 0UL )
+	{
+		return 0;
+	}
+
+	/* A start bit, 5 to 8 data bits, the parity bit if there is one and 1 or
+	2 stop bits, each 16 cycles of the peripheral clock divided by the
+	divisor latch. */
+	ulBits = 1UL + 5UL + ( unsigned long ) ( pxUART->ucLCR & simLCR_WORD_LENGTH );
+	ulBits += ( ( pxUART->ucLCR & simLCR_PARITY ) != 0 ) ? 1UL : 0UL;
+	ulBits += ( ( pxUART->ucLCR & simLCR_STOP_2 ) != 0 ) ? 2UL : 1UL;
+
+	return ( xSimTime ) prvPCLKDivider() * 16ULL * ( xSimTime ) ulDivisor * ( xSimTime ) ulBits;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTTxStart( xSimUART *pxUART )
+{
+xSimTime xCycles = prvUARTCharCycles( pxUART );
+
+	if( ( pxUART->iShifting != 0 ) || ( pxUART->iTxCount == 0 ) || ( xCycles == 0 ) || ( ( pxUART->ucLCR & simLCR_DLAB ) != 0 ) )
+	{
+		return;
+	}
+
+	pxUART->ucShift = pxUART->ucTxFifo[ pxUART->iTxHead ];
+	pxUART->iTxHead = ( pxUART->iTxHead + 1 ) % simFIFO_LENGTH;
+	pxUART->iTxCount--;
+	pxUART->iShifting = 1;
+	vSimEventSchedule( &pxUART->xTxDone, xSimNow() + xCycles );
+
+	if( pxUART->iTxCount == 0 )
+	{
+		pxUART->iTHREPending = 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTTxDone( xSimEvent *pxEvent )
+{
+xSimUART *pxUART = ( xSimUART * ) pxEvent->pvContext;
+
+	if( pxUART->iOutFd >= 0 )
+	{
+		( void ) write( pxUART->iOutFd, &pxUART->ucShift, 1 );
+	}
+
+	pxUART->iShifting = 0;
+	prvUARTTxStart( pxUART );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTRxNext( xSimEvent *pxEvent )
+{
+xSimUART *pxUART = ( xSimUART * ) pxEvent->pvContext;
+xSimTime xCycles = prvUARTCharCycles( pxUART );
+unsigned char ucChar;
+ssize_t xRead;
+
+	if( ( xCycles == 0 ) || ( ( pxUART->ucLCR & simLCR_DLAB ) != 0 ) )
+	{
+		/* The port is not set up yet, look again next tick. */
+		vSimEventSchedule( pxEvent, xSimNow() + simCYCLES_PER_TICK );
+		return;
+	}
+
+	xRead = read( pxUART->iInFd, &ucChar, 1 );
+
+	if( xRead == 1 )
+	{
+		if( pxUART->iRxCount < simFIFO_LENGTH )
+		{
+			pxUART->ucRxFifo[ ( pxUART->iRxHead + pxUART->iRxCount ) % simFIFO_LENGTH ] = ucChar;
+			pxUART->iRxCount++;
+		}
+		else
+		{
+			pxUART->ucErrors |= simLSR_OE;
+		}
+
+		pxUART->xRxActivity = xSimNow();
+		vSimEventSchedule( &pxUART->xRxTimeout, xSimNow() + ( simCTI_CHARS * xCycles ) );
+
+		/* The next character can finish one character time from now at the
+		earliest. */
+		vSimEventSchedule( pxEvent, xSimNow() + xCycles );
+	}
+	else if( xRead == 0 )
+	{
+		/* End of file, the line stays idle from now on. */
+		pxUART->iInFd = -1;
+	}
+	else
+	{
+		/* Nothing to read yet, look again next tick. */
+		vSimEventSchedule( pxEvent, xSimNow() + simCYCLES_PER_TICK );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTRxTimeout( xSimEvent *pxEvent )
+{
+	/* Nothing to do, prvUARTSource() sees the timeout once the time has come
+	and prvDispatch() runs after every event. */
+	( void ) pxEvent;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char prvUARTSource( xSimUART *pxUART )
+{
+int iTrigger = "\x01\x04\x08\x0e"[ pxUART->ucFCR >> 6 ];
+xSimTime xCycles;
+
+	/* Highest priority source first. */
+	if( ( ( pxUART->ucIER & simIER_RLS ) != 0 ) && ( pxUART->ucErrors != 0 ) )
+	{
+		return simIIR_RLS;
+	}
+
+	if( ( ( pxUART->ucIER & simIER_RDA ) != 0 ) && ( pxUART->iRxCount >= iTrigger ) )
+	{
+		return simIIR_RDA;
+	}
+
+	if( ( ( pxUART->ucIER & simIER_RDA ) != 0 ) && ( pxUART->iRxCount > 0 ) )
+	{
+		xCycles = prvUARTCharCycles( pxUART );
+
+		if( ( xCycles != 0 ) && ( ( xSimNow() - pxUART->xRxActivity ) >= ( simCTI_CHARS * xCycles ) ) )
+		{
+			return simIIR_CTI;
+		}
+	}
+
+	if( ( ( pxUART->ucIER & simIER_THRE ) != 0 ) && ( pxUART->iTHREPending != 0 ) )
+	{
+		return simIIR_THRE;
+	}
+
+	return simIIR_NONE;
+}
+/*-----------------------------------------------------------*/
+
+static xSimTimer *prvFindTimer( unsigned long ulBase )
+{
+int iIndex;
+
+	for( iIndex = 0; iIndex < simNUM_TIMERS; iIndex++ )
+	{
+		if( xTimers[ iIndex ].ulBase == ulBase )
+		{
+			return &xTimers[ iIndex ];
+		}
+	}
+
+	fprintf( stderr, "lpc21xx_sim: no timer at 0x%08lx\n", ulBase );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+static int prvTimerRunning( xSimTimer *pxTimer )
+{
+	return ( pxTimer->ulTCR & ( simTCR_ENABLE | simTCR_RESET ) ) == simTCR_ENABLE;
+}
+/*-----------------------------------------------------------*/
+
+static xSimTime prvTimerCycles( xSimTimer *pxTimer )
+{
+	/* Processor cycles per count of the TC. */
+	return ( xSimTime ) prvPCLKDivider() * ( ( xSimTime ) pxTimer->ulPR + 1ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerSync( xSimTimer *pxTimer )
+{
+xSimTime xCycles = prvTimerCycles( pxTimer );
+xSimTime xElapsed = xSimNow() - pxTimer->xStart;
+
+	/* Fold the counts since xStart into ulTC, keeping the prescaler's
+	progress towards the next one. */
+	if( prvTimerRunning( pxTimer ) != 0 )
+	{
+		pxTimer->ulTC = ( pxTimer->ulTC + ( unsigned long ) ( xElapsed / xCycles ) ) & simTIMER_MASK;
+		pxTimer->xStart = xSimNow() - ( xElapsed % xCycles );
+	}
+	else
+	{
+		pxTimer->xStart = xSimNow();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerSchedule( xSimTimer *pxTimer )
+{
+int iMatch;
+xSimTime xCounts, xNearest = 0;
+
+	/* Only called straight after prvTimerSync(), so ulTC is the count at
+	xStart. */
+	vSimEventCancel( &pxTimer->xMatch );
+
+	if( prvTimerRunning( pxTimer ) == 0 )
+	{
+		return;
+	}
+
+	for( iMatch = 0; iMatch < simNUM_MATCH; iMatch++ )
+	{
+		if( ( ( pxTimer->ulMCR >> ( 3 * iMatch ) ) & simMCR_ACTIONS ) == 0UL )
+		{
+			continue;
+		}
+
+		/* A match register the TC has only just reached matches again
+		after the TC wraps. */
+		xCounts = ( xSimTime ) ( ( pxTimer->ulMR[ iMatch ] - pxTimer->ulTC ) & simTIMER_MASK );
+
+		if( xCounts == 0 )
+		{
+			xCounts = ( xSimTime ) simTIMER_MASK + 1ULL;
+		}
+
+		if( ( xNearest == 0 ) || ( xCounts < xNearest ) )
+		{
+			xNearest = xCounts;
+		}
+	}
+
+	if( xNearest != 0 )
+	{
+		vSimEventSchedule( &pxTimer->xMatch, pxTimer->xStart + ( xNearest * prvTimerCycles( pxTimer ) ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerMatch( xSimEvent *pxEvent )
+{
+xSimTimer *pxTimer = ( xSimTimer * ) pxEvent->pvContext;
+int iMatch, iReset = 0;
+unsigned long ulActions;
+
+	prvTimerSync( pxTimer );
+
+	for( iMatch = 0; iMatch < simNUM_MATCH; iMatch++ )
+	{
+		ulActions = ( pxTimer->ulMCR >> ( 3 * iMatch ) ) & simMCR_ACTIONS;
+
+		if( ( ulActions == 0UL ) || ( pxTimer->ulMR[ iMatch ] != pxTimer->ulTC ) )
+		{
+			continue;
+		}
+
+		if( ( ulActions & simMCR_INTERRUPT ) != 0UL )
+		{
+			pxTimer->ulIR |= ( 1UL << iMatch );
+		}
+
+		if( ( ulActions & simMCR_RESET ) != 0UL )
+		{
+			iReset = 1;
+		}
+
+		if( ( ulActions & simMCR_STOP ) != 0UL )
+		{
+			pxTimer->ulTCR &= ~simTCR_ENABLE;
+		}
+	}
+
+	/* The TC is reset in the cycle it matches, so a timer that resets on
+	MRn counts MRn cycles of its prescaler per period. */
+	if( iReset != 0 )
+	{
+		pxTimer->ulTC = 0;
+	}
+
+	prvTimerSchedule( pxTimer );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimTimerRead( unsigned long ulBase, unsigned long ulOffset )
+{
+xSimTimer *pxTimer = prvFindTimer( ulBase );
+unsigned long ulValue = 0;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvTimerSync( pxTimer );
+
+		switch( ulOffset )
+		{
+			case simTxIR :
+				ulValue = pxTimer->ulIR;
+				break;
+
+			case simTxTCR :
+				ulValue = pxTimer->ulTCR;
+				break;
+
+			case simTxTC :
+				ulValue = pxTimer->ulTC;
+				break;
+
+			case simTxPR :
+				ulValue = pxTimer->ulPR;
+				break;
+
+			case simTxPC :
+				ulValue = ( unsigned long ) ( ( xSimNow() - pxTimer->xStart ) / prvPCLKDivider() );
+				break;
+
+			case simTxMCR :
+				ulValue = pxTimer->ulMCR;
+				break;
+
+			default :
+				if( ( ulOffset >= simTxMR0 ) && ( ulOffset < ( simTxMR0 + ( 4 * simNUM_MATCH ) ) ) )
+				{
+					ulValue = pxTimer->ulMR[ ( ulOffset - simTxMR0 ) / 4 ];
+				}
+				break;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+void vSimTimerWrite( unsigned long ulBase, unsigned long ulOffset, unsigned long ulValue )
+{
+xSimTimer *pxTimer = prvFindTimer( ulBase );
+UBaseType_t uxSavedInterruptStatus;
+
+	ulValue &= simTIMER_MASK;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvTimerSync( pxTimer );
+
+		switch( ulOffset )
+		{
+			case simTxIR :
+				/* Writing a one clears the interrupt. */
+				pxTimer->ulIR &= ~ulValue;
+				break;
+
+			case simTxTCR :
+				pxTimer->ulTCR = ulValue & ( simTCR_ENABLE | simTCR_RESET );
+
+				if( ( ulValue & simTCR_RESET ) != 0UL )
+				{
+					pxTimer->ulTC = 0;
+				}
+				break;
+
+			case simTxTC :
+				pxTimer->ulTC = ulValue;
+				break;
+
+			case simTxPR :
+				/* The prescale counter starts again. */
+				pxTimer->ulPR = ulValue;
+				pxTimer->xStart = xSimNow();
+				break;
+
+			case simTxMCR :
+				pxTimer->ulMCR = ulValue & simMCR_ALL;
+				break;
+
+			default :
+				/* Writes to the PC are not modelled. */
+				if( ( ulOffset >= simTxMR0 ) && ( ulOffset < ( simTxMR0 + ( 4 * simNUM_MATCH ) ) ) )
+				{
+					pxTimer->ulMR[ ( ulOffset - simTxMR0 ) / 4 ] = ulValue;
+				}
+				break;
+		}
+
+		prvTimerSchedule( pxTimer );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvEintLevels( unsigned long *pulRouted )
+{
+unsigned long ulLevels = 0, ulRouted = 0;
+unsigned int uxIndex;
+const xSimEintPin *pxPin;
+
+	/* Where two pins are routed to the same line the first in the table 
+	wins. */
+	for( uxIndex = 0; uxIndex < ( sizeof( xEintPins ) / sizeof( xEintPins[ 0 ] ) ); uxIndex++ )
+	{
+		pxPin = &xEintPins[ uxIndex ];
+
+		if( ( ( ( *pxPin->pulPINSEL >> pxPin->ulShift ) & 0x03UL ) == pxPin->ulFunction ) && ( ( ulRouted & ( 1UL << pxPin->ulLine ) ) == 0UL ) )
+		{
+			ulRouted |= 1UL << pxPin->ulLine;
+			ulLevels |= ( ( ulInputs[ 0 ] >> pxPin->iPin ) & 1UL ) << pxPin->ulLine;
+		}
+	}
+
+	*pulRouted = ulRouted;
+	return ulLevels;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEintSample( void )
+{
+unsigned long ulRouted;
+unsigned long ulLevels = prvEintLevels( &ulRouted );
+unsigned long ulActive, ulEdges;
+
+	/* EXTPOLAR picks the active level, or the edge into it.  A line with no
+	pin routed to it never fires. */
+	ulActive = ~( ulLevels ^ ulEXTPOLAR ) & ulRouted;
+	ulEdges = ulActive & ( ulLevels ^ ulEintLevels );
+
+	ulEXTINT |= ( ulEdges & ulEXTMODE ) | ( ulActive & ~ulEXTMODE & simEINT_MASK );
+	ulEintLevels = ulLevels;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimEINTRead( unsigned long ulOffset )
+{
+unsigned long ulValue = 0;
+
+	switch( ulOffset )
+	{
+		case simEXTINT :
+			ulValue = ulEXTINT;
+			break;
+
+		case simEXTWAKE :
+			ulValue = ulEXTWAKE;
+			break;
+
+		case simEXTMODE :
+			ulValue = ulEXTMODE;
+			break;
+
+		case simEXTPOLAR :
+			ulValue = ulEXTPOLAR;
+			break;
+
+		default :
+			break;
+	}
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+void vSimEINTWrite( unsigned long ulOffset, unsigned long ulValue )
+{
+UBaseType_t uxSavedInterruptStatus;
+unsigned long ulRouted;
+
+	ulValue &= simEINT_MASK;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		switch( ulOffset )
+		{
+			case simEXTINT :
+				/* Writing a one clears the flag, which a level still there 
+				sets again straight away. */
+				ulEXTINT &= ~ulValue;
+				break;
+
+			case simEXTWAKE :
+				ulEXTWAKE = ulValue;
+				break;
+
+			case simEXTMODE :
+				ulEXTMODE = ulValue;
+				break;
+
+			case simEXTPOLAR :
+				ulEXTPOLAR = ulValue;
+				break;
+
+			default :
+				break;
+		}
+
+		/* Only a level sets the flag here, an edge needs an input change. */
+		ulEintLevels = prvEintLevels( &ulRouted );
+		ulEXTINT |= ~( ulEintLevels ^ ulEXTPOLAR ) & ~ulEXTMODE & ulRouted;
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTickTimer( void )
+{
+	/* As the port's prvSetupTimerInterrupt() does on the target: no
+	prescaling, interrupt and reset on MR0. */
+	vSimTimerWrite( simTIMER0_BASE, simTxPR, 0UL );
+	vSimTimerWrite( simTIMER0_BASE, simTxMR0, configCPU_CLOCK_HZ / configTICK_RATE_HZ );
+	vSimTimerWrite( simTIMER0_BASE, simTxMCR, simMCR_INTERRUPT | simMCR_RESET );
+	vSimTimerWrite( simTIMER0_BASE, simTxTCR, simTCR_ENABLE );
+}
+/*-----------------------------------------------------------*/
+
+static int prvRaiseIRQ( unsigned long ulChannel )
+{
+int iSlot;
+void ( *pvHandler )( void );
+
+	/* VICIntEnClr masks the channels written to it. */
+	ulSimVICIntEnable &= ~ulSimVICIntEnClr;
+	ulSimVICIntEnClr = 0;
+
+	if( ( ulSimVICIntEnable & ( 1UL << ulChannel ) ) == 0 )
+	{
+		return 0;
+	}
+
+	for( iSlot = 0; iSlot < simNUM_VIC_SLOTS; iSlot++ )
+	{
+		if( ulSimVICVectCntlN[ iSlot ] == ( ulChannel | simVIC_SLOT_ENABLE ) )
+		{
+			pvHandler = ( void ( * )( void ) ) ulSimVICVectAddrN[ iSlot ];
+			ulSimVICVectAddr = ( unsigned long ) pvHandler;
+			pvHandler();
+			return 1;
+		}
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDispatch( void )
+{
+int iIndex, iDispatches;
+
+	/* Peek at the UART interrupt sources rather than read the IIR, which
+	would clear a THRE interrupt. */
+	for( iIndex = 0; iIndex < simNUM_UARTS; iIndex++ )
+	{
+		for( iDispatches = 0; iDispatches < simMAX_DISPATCHES; iDispatches++ )
+		{
+			if( ( prvUARTSource( &xUARTs[ iIndex ] ) == simIIR_NONE ) || ( prvRaiseIRQ( xUARTs[ iIndex ].ulChannel ) == 0 ) )
+			{
+				break;
+			}
+		}
+	}
+
+	for( iIndex = 0; iIndex < simNUM_TIMERS; iIndex++ )
+	{
+		for( iDispatches = 0; iDispatches < simMAX_DISPATCHES; iDispatches++ )
+		{
+			if( ( ( xTimers[ iIndex ].ulIR & simIR_MATCH ) == 0UL ) || ( prvRaiseIRQ( xTimers[ iIndex ].ulChannel ) == 0 ) )
+			{
+				break;
+			}
+		}
+	}
+
+	for( iIndex = 0; iIndex < simNUM_EINTS; iIndex++ )
+	{
+		for( iDispatches = 0; iDispatches < simMAX_DISPATCHES; iDispatches++ )
+		{
+			if( ( ( ulEXTINT & ( 1UL << iIndex ) ) == 0UL ) || ( prvRaiseIRQ( simEINT_CHANNEL + ( unsigned long ) iIndex ) == 0 ) )
+			{
+				break;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvApplyStimuli( void )
+{
+xSimStimulus *pxStimulus;
+
+	while( ( iNextStimulus < iNumStimuli ) && ( ( ulScriptStart + xStimuli[ iNextStimulus ].ulTick ) <= ulTick ) )
+	{
+		pxStimulus = &xStimuli[ iNextStimulus ];
+
+		if( pxStimulus->iLevel != 0 )
+		{
+			ulInputs[ pxStimulus->iPort ] |= ( 1UL << pxStimulus->iPin );
+		}
+		else
+		{
+			ulInputs[ pxStimulus->iPort ] &= ~( 1UL << pxStimulus->iPin );
+		}
+
+		iNextStimulus++;
+
+		if( ( iNextStimulus == iNumStimuli ) && ( ulRepeatTicks != 0UL ) )
+		{
+			iNextStimulus = 0;
+			ulScriptStart += ulRepeatTicks;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static long prvPWMOffsetToMatch( unsigned long ulOffset )
+{
+	if( ( ulOffset >= simPWMMR0 ) && ( ulOffset < ( simPWMMR0 + 16 ) ) )
+	{
+		return ( long ) ( ( ulOffset - simPWMMR0 ) / 4 );
+	}
+
+	if( ( ulOffset >= simPWMMR4 ) && ( ulOffset < ( simPWMMR4 + 12 ) ) )
+	{
+		return ( long ) ( 4 + ( ( ulOffset - simPWMMR4 ) / 4 ) );
+	}
+
+	return -1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPWMSync( void )
+{
+xSimTime xCycles = ( xSimTime ) prvPCLKDivider() * ( ( xSimTime ) xPWM.ulPR + 1ULL );
+xSimTime xElapsed = xSimNow() - xPWM.xStart;
+xSimTime xCounts = xElapsed / xCycles;
+xSimTime xToReset;
+int iMatch;
+
+	if( ( xPWM.ulTCR & ( simTCR_ENABLE | simTCR_RESET ) ) != simTCR_ENABLE )
+	{
+		xPWM.xStart = xSimNow();
+		return;
+	}
+
+	xPWM.xStart = xSimNow() - ( xElapsed % xCycles );
+
+	if( ( ( xPWM.ulMCR & simMCR_RESET ) == 0UL ) || ( xPWM.ulMR[ 0 ] == 0UL ) )
+	{
+		xPWM.ulTC = ( unsigned long ) ( ( xPWM.ulTC + xCounts ) & simTIMER_MASK );
+		return;
+	}
+
+	/* A count already past MR0 runs on to the wrap first. */
+	xToReset = ( xSimTime ) ( ( xPWM.ulMR[ 0 ] - xPWM.ulTC ) & simTIMER_MASK );
+
+	if( xCounts < xToReset )
+	{
+		xPWM.ulTC += ( unsigned long ) xCounts;
+		return;
+	}
+
+	/* Latched values take over at the first reset and hold after it, so
+	the rest is whole periods of the new MR0. */
+	for( iMatch = 0; iMatch < simNUM_PWM_MATCH; iMatch++ )
+	{
+		if( ( xPWM.ulLER & ( 1UL << iMatch ) ) != 0UL )
+		{
+			xPWM.ulMR[ iMatch ] = xPWM.ulShadow[ iMatch ];
+		}
+	}
+
+	xPWM.ulLER = 0;
+	xCounts -= xToReset;
+	xPWM.ulTC = ( xPWM.ulMR[ 0 ] == 0UL ) ? ( unsigned long ) xCounts : ( unsigned long ) ( xCounts % xPWM.ulMR[ 0 ] );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvPWMLevels( unsigned long *pulDriven )
+{
+unsigned long ulLevels = 0, ulChannel;
+size_t xIndex;
+
+	*pulDriven = 0;
+	prvPWMSync();
+
+	for( xIndex = 0; xIndex < ( sizeof( xPWMPins ) / sizeof( xPWMPins[ 0 ] ) ); xIndex++ )
+	{
+		ulChannel = xPWMPins[ xIndex ].ulChannel;
+
+		if( ( ( ulSimPINSEL1 >> xPWMPins[ xIndex ].ulShift ) & 3UL ) != 1UL )
+		{
+			continue;
+		}
+
+		*pulDriven |= 1UL << xPWMPins[ xIndex ].iPin;
+
+		/* An output that is not enabled holds low.  An enabled one is set 
+		as the count resets and cleared when it reaches MRn. */
+		if( ( ( xPWM.ulPCR & ( 0x100UL << ulChannel ) ) != 0UL ) && 
+			( ( xPWM.ulTCR & ( simTCR_ENABLE | simPWMTCR_PWM_ENABLE ) ) == ( simTCR_ENABLE | simPWMTCR_PWM_ENABLE ) ) &&
+			( xPWM.ulTC < xPWM.ulMR[ ulChannel ] ) )
+		{
+			ulLevels |= 1UL << xPWMPins[ xIndex ].iPin;
+		}
+	}
+
+	return ulLevels;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimPWMRead( unsigned long ulOffset )
+{
+unsigned long ulValue = 0;
+long lMatch;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvPWMSync();
+
+		switch( ulOffset )
+		{
+			case simPWMTCR :
+				ulValue = xPWM.ulTCR;
+				break;
+
+			case simPWMTC :
+				ulValue = xPWM.ulTC;
+				break;
+
+			case simPWMPR :
+				ulValue = xPWM.ulPR;
+				break;
+
+			case simPWMMCR :
+				ulValue = xPWM.ulMCR;
+				break;
+
+			case simPWMPCR :
+				ulValue = xPWM.ulPCR;
+				break;
+
+			case simPWMLER :
+				ulValue = xPWM.ulLER;
+				break;
+
+			default :
+				lMatch = prvPWMOffsetToMatch( ulOffset );
+
+				if( lMatch >= 0 )
+				{
+					ulValue = xPWM.ulShadow[ lMatch ];
+				}
+				break;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+void vSimPWMWrite( unsigned long ulOffset, unsigned long ulValue )
+{
+long lMatch;
+int iMatch;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvPWMSync();
+
+		switch( ulOffset )
+		{
+			case simPWMTCR :
+				xPWM.ulTCR = ulValue;
+
+				if( ( ulValue & simTCR_RESET ) != 0UL )
+				{
+					xPWM.ulTC = 0;
+				}
+				break;
+
+			case simPWMTC :
+				xPWM.ulTC = ulValue;
+				break;
+
+			case simPWMPR :
+				xPWM.ulPR = ulValue;
+				break;
+
+			case simPWMMCR :
+				xPWM.ulMCR = ulValue;
+				break;
+
+			case simPWMPCR :
+				xPWM.ulPCR = ulValue;
+				break;
+
+			case simPWMLER :
+				xPWM.ulLER |= ulValue;
+
+				/* A stopped counter takes the values straight away, as the
+				next reset is when it starts. */
+				if( ( xPWM.ulTCR & simTCR_ENABLE ) == 0UL )
+				{
+					for( iMatch = 0; iMatch < simNUM_PWM_MATCH; iMatch++ )
+					{
+						if( ( xPWM.ulLER & ( 1UL << iMatch ) ) != 0UL )
+						{
+							xPWM.ulMR[ iMatch ] = xPWM.ulShadow[ iMatch ];
+						}
+					}
+
+					xPWM.ulLER = 0;
+				}
+				break;
+
+			default :
+				lMatch = prvPWMOffsetToMatch( ulOffset );
+
+				if( lMatch >= 0 )
+				{
+					xPWM.ulShadow[ lMatch ] = ulValue;
+
+					/* Without PWM mode a write goes straight through. */
+					if( ( xPWM.ulTCR & simPWMTCR_PWM_ENABLE ) == 0UL )
+					{
+						xPWM.ulMR[ lMatch ] = ulValue;
+					}
+				}
+				break;
+		}
+
+		prvCommitGPIO();
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vSimTick( unsigned long ulTickCount )
+{
+xSimTimer *pxTickTimer = &xTimers[ 0 ];
+xSimTime xUntil;
+
+	ulTick = ulTickCount;
+
+	if( ( ulStopTick != 0UL ) && ( ulTick >= ulStopTick ) )
+	{
+		prvReport();
+		_exit( EXIT_SUCCESS );
+	}
+
+	if( iTickStarted == 0 )
+	{
+		prvStartTickTimer();
+		iTickStarted = 1;
+	}
+
+	/* Simulated time moves on to the Timer0 match this tick stands for. */
+	if( iSimEventScheduled( &pxTickTimer->xMatch ) != 0 )
+	{
+		xUntil = pxTickTimer->xMatch.xWhen;
+	}
+	else
+	{
+		xUntil = xSimNow() + simCYCLES_PER_TICK;
+	}
+
+	vSimRunUntil( xUntil, prvDispatch );
+
+	/* Clear the match, as the port's tick ISR does. */
+	pxTickTimer->ulIR &= ~simIR_MR0;
+
+	prvApplyStimuli();
+	prvEintSample();
+	prvCommitGPIO();
+
+	/* Anything raised by the tasks since the last tick. */
+	prvDispatch();
+}
+/*-----------------------------------------------------------*/
+
+void vSimIdle( void )
+{
+	if( ulSpeed == 0UL )
+	{
+		/* Nothing is ready to run before the next tick, so take it now.  The
+		port's tick handler runs on the thread of the task it interrupts,
+		here the idle task. */
+		( void ) pthread_kill( pthread_self(), SIGALRM );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( hostSIM_IDLE_HOOK == 1 )
+
+	void vApplicationIdleHook( void )
+	{
+		vSimIdle();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+int __wrap_setitimer( int iWhich, const struct itimerval *pxNew, struct itimerval *pxOld )
+{
+struct itimerval xScaled;
+
+	if( ( iWhich != ITIMER_REAL ) || ( pxNew == NULL ) || ( ulSpeed == 1UL ) )
+	{
+		return __real_setitimer( iWhich, pxNew, pxOld );
+	}
+
+	xScaled = *pxNew;
+	prvScaleInterval( &xScaled.it_interval );
+	prvScaleInterval( &xScaled.it_value );
+
+	return __real_setitimer( iWhich, &xScaled, pxOld );
+}
+/*-----------------------------------------------------------*/
+
+static void prvScaleInterval( struct timeval *pxInterval )
+{
+unsigned long long ullMicroseconds;
+
+	ullMicroseconds = ( ( unsigned long long ) pxInterval->tv_sec * 1000000ULL ) + ( unsigned long long ) pxInterval->tv_usec;
+
+	/* Zero disarms the timer and must stay zero. */
+	if( ullMicroseconds == 0ULL )
+	{
+		return;
+	}
+
+	if( ulSpeed != 0UL )
+	{
+		ullMicroseconds /= ulSpeed;
+	}
+
+	if( ( ulSpeed == 0UL ) || ( ullMicroseconds < simFASTEST_TICK_US ) )
+	{
+		ullMicroseconds = simFASTEST_TICK_US;
+	}
+
+	pxInterval->tv_sec = ( time_t ) ( ullMicroseconds / 1000000ULL );
+	pxInterval->tv_usec = ( suseconds_t ) ( ullMicroseconds % 1000000ULL );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimHostCycles( void )
+{
+struct timespec xNow;
+unsigned long long ullNanoseconds;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	ullNanoseconds = ( ( unsigned long long ) xNow.tv_sec * 1000000000ULL ) + ( unsigned long long ) xNow.tv_nsec;
+
+	/* The processor clock is a whole number of MHz. */
+	return ( unsigned long ) ( ( ullNanoseconds * ( configCPU_CLOCK_HZ / 1000000ULL ) ) / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( void )
+{
+struct timespec xNow;
+double dSimulated, dElapsed;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	dSimulated = ( double ) xSimNow() / ( double ) configCPU_CLOCK_HZ;
+	dElapsed = ( double ) ( xNow.tv_sec - xStarted.tv_sec ) + ( ( double ) ( xNow.tv_nsec - xStarted.tv_nsec ) / 1e9 );
+
+	fprintf( stderr, "lpc21xx_sim: %lu ticks, %.3f s simulated in %.3f s\n", ulTick, dSimulated, dElapsed );
+}
+/*-----------------------------------------------------------*/
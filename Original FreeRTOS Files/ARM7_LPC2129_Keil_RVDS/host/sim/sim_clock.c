@@ -0,0 +1,113 @@
+/*
+ * Virtual clock and event queue for the host simulator, see sim_clock.h.
+ *
+ * The queue is a list kept in time order.  The models only ever have a
+ * handful of events pending, one or two per peripheral, so a heap would not
+ * pay for itself.
+ */
+
+#include <stddef.h>
+
+#include "sim_clock.h"
+
+/*-----------------------------------------------------------*/
+
+static xSimEvent *pxPending = NULL;
+static xSimTime xNow = 0;
+
+/*-----------------------------------------------------------*/
+
+void vSimEventInit( xSimEvent *pxEvent, void ( *pvHandler )( xSimEvent *pxEvent ), void *pvContext )
+{
+	pxEvent->xWhen = 0;
+	pxEvent->pvHandler = pvHandler;
+	pxEvent->pvContext = pvContext;
+	pxEvent->pxNext = NULL;
+	pxEvent->iScheduled = 0;
+}
+/*-----------------------------------------------------------*/
+
+void vSimEventSchedule( xSimEvent *pxEvent, xSimTime xWhen )
+{
+xSimEvent **ppxLink;
+
+	vSimEventCancel( pxEvent );
+
+	if( xWhen < xNow )
+	{
+		xWhen = xNow;
+	}
+
+	/* Behind everything already due at the same time. */
+	for( ppxLink = &pxPending; ( *ppxLink != NULL ) && ( ( *ppxLink )->xWhen <= xWhen ); ppxLink = &( ( *ppxLink )->pxNext ) )
+	{
+	}
+
+	pxEvent->xWhen = xWhen;
+	pxEvent->pxNext = *ppxLink;
+	pxEvent->iScheduled = 1;
+	*ppxLink = pxEvent;
+}
+/*-----------------------------------------------------------*/
+
+void vSimEventCancel( xSimEvent *pxEvent )
+{
+xSimEvent **ppxLink;
+
+	if( pxEvent->iScheduled == 0 )
+	{
+		return;
+	}
+
+	for( ppxLink = &pxPending; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+	{
+		if( *ppxLink == pxEvent )
+		{
+			*ppxLink = pxEvent->pxNext;
+			break;
+		}
+	}
+
+	pxEvent->pxNext = NULL;
+	pxEvent->iScheduled = 0;
+}
+/*-----------------------------------------------------------*/
+
+int iSimEventScheduled( const xSimEvent *pxEvent )
+{
+	return pxEvent->iScheduled;
+}
+/*-----------------------------------------------------------*/
+
+xSimTime xSimNow( void )
+{
+	return xNow;
+}
+/*-----------------------------------------------------------*/
+
+void vSimRunUntil( xSimTime xUntil, void ( *pvAfterEvent )( void ) )
+{
+xSimEvent *pxEvent;
+
+	while( ( pxPending != NULL ) && ( pxPending->xWhen <= xUntil ) )
+	{
+		pxEvent = pxPending;
+		pxPending = pxEvent->pxNext;
+		pxEvent->pxNext = NULL;
+		pxEvent->iScheduled = 0;
+
+		xNow = pxEvent->xWhen;
+		pxEvent->pvHandler( pxEvent );
+
+		if( pvAfterEvent != NULL )
+		{
+			pvAfterEvent();
+		}
+	}
+
+	if( xUntil > xNow )
+	{
+		xNow = xUntil;
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,43 @@
+/*
+ * Virtual clock and event queue for the host simulator.
+ *
+ * Simulated time is counted in processor clock cycles from reset and only
+ * moves when vSimRunUntil() is called, never with the wall clock.  Each model
+ * owns the xSimEvent structures it needs and schedules them for the cycle at
+ * which something happens on the hardware: a character finishing on the
+ * line, a timer reaching a match register.  Events due at the same cycle run
+ * in the order they were scheduled, so a run is repeatable.
+ *
+ * Nothing here locks.  The callers serialise access, see lpc21xx_sim.c.
+ */
+
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+typedef unsigned long long xSimTime;
+
+typedef struct SIM_EVENT
+{
+	xSimTime xWhen;
+	void ( *pvHandler )( struct SIM_EVENT *pxEvent );
+	void *pvContext;
+	struct SIM_EVENT *pxNext;
+	int iScheduled;
+} xSimEvent;
+
+void vSimEventInit( xSimEvent *pxEvent, void ( *pvHandler )( xSimEvent *pxEvent ), void *pvContext );
+
+/* Schedules the event for xWhen, or now if xWhen has already passed.  An
+event that is already scheduled is moved. */
+void vSimEventSchedule( xSimEvent *pxEvent, xSimTime xWhen );
+void vSimEventCancel( xSimEvent *pxEvent );
+int iSimEventScheduled( const xSimEvent *pxEvent );
+
+xSimTime xSimNow( void );
+
+/* Runs every event due up to and including xUntil, in time order, with the
+clock set to each event's time as it runs, then leaves the clock at xUntil.
+pvAfterEvent, if not NULL, is called after each event. */
+void vSimRunUntil( xSimTime xUntil, void ( *pvAfterEvent )( void ) );
+
+#endif /* SIM_CLOCK_H */
@@ -31,6 +31,20 @@
 
 	Note this driver is used to test the FreeRTOS port.  It is NOT intended to
 	be an example of an efficient implementation!
+
+	Defining serUSE_RING_BUFFERS as 1 passes characters between the tasks and
+	the ISR through a pair of single producer/single consumer ring buffers 
+	instead of the original queues.  The producer only ever writes the head 
+	index and the consumer only ever writes the tail index, so neither side
+	needs a critical section or a kernel call per character.  Each THRE 
+	interrupt refills the whole 16 byte Tx FIFO and each Rx interrupt drains
+	the Rx FIFO, so with the Rx trigger level above one character there is 
+	roughly one interrupt per FIFO load rather than one per character.  The
+	queue engine stays the default until the two have been compared with 
+	serialbench.c, see Benchmarks/Serial Engines.
+
+	The Tx ring has a single producer, so tasks that share the port must
+	serialise their calls to xSerialPutChar() and vSerialPutString().
 */
 
 /* Standard includes. */
@@ -46,6 +60,34 @@
 
 /*-----------------------------------------------------------*/
 
+/* Select the Tx/Rx engine.  Must match the setting used by serialbench.c. */
+#ifndef serUSE_RING_BUFFERS
+	#define serUSE_RING_BUFFERS			0
+#endif
+
+/* UART1's register block and the offset of each register within it. */
+#define serUART1_BASE					( ( unsigned long ) 0xE0010000 )
+
+#define serRBR							( 0x00 )
+#define serTHR							( 0x00 )
+#define serDLL							( 0x00 )
+#define serIER							( 0x04 )
+#define serDLM							( 0x04 )
+#define serIIR							( 0x08 )
+#define serFCR							( 0x08 )
+#define serLCR							( 0x0C )
+#define serLSR							( 0x14 )
+
+/* Register accessors, in the form the Starter serial.c uses.  The host build
+in ../host supplies its own so the registers can be simulated. */
+#ifndef serREAD
+	#define serREAD( pxUART, ulOffset )				( *( ( volatile unsigned char * ) ( ( pxUART )->ulBase + ( ulOffset ) ) ) )
+	#define serWRITE( pxUART, ulOffset, ucValue )	( serREAD( pxUART, ulOffset ) = ( unsigned char ) ( ucValue ) )
+#endif
+
+#define serU1READ( ulOffset )			serREAD( &xUART1, ( ulOffset ) )
+#define serU1WRITE( ulOffset, ucValue )	serWRITE( &xUART1, ( ulOffset ), ( ucValue ) )
+
 /* Constants to setup and access the UART. */
 #define serDLAB							( ( unsigned char ) 0x80 )
 #define serENABLE_INTERRUPTS			( ( unsigned char ) 0x03 )
@@ -55,6 +97,20 @@
 #define serFIFO_ON						( ( unsigned char ) 0x01 )
 #define serCLEAR_FIFO					( ( unsigned char ) 0x06 )
 #define serWANTED_CLOCK_SCALING			( ( unsigned long ) 16 )
+#define serDATA_READY					( ( unsigned char ) 0x01 )
+#define serTX_FIFO_LENGTH				( 16 )
+
+/* Rx FIFO trigger levels.  The Rx interrupt is raised once this many
+characters are in the FIFO, and the character timeout interrupt collects any
+that are left when the line goes quiet. */
+#define serFCR_RX_TRIGGER_1				( ( unsigned char ) 0x00 )
+#define serFCR_RX_TRIGGER_4				( ( unsigned char ) 0x40 )
+#define serFCR_RX_TRIGGER_8				( ( unsigned char ) 0x80 )
+#define serFCR_RX_TRIGGER_14			( ( unsigned char ) 0xc0 )
+
+#ifndef serFCR_RX_TRIGGER_LEVEL
+	#define serFCR_RX_TRIGGER_LEVEL			serFCR_RX_TRIGGER_8
+#endif
 
 /* Constants to setup and access the VIC. */
 #define serU1VIC_CHANNEL				( ( unsigned long ) 0x0007 )
@@ -77,6 +133,13 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* Sizes of the Rx and Tx rings.  These must be powers of two so the free
+running indexes can be wrapped with a mask.  The uxQueueLength parameter of
+xSerialPortInitMinimal() is not used by the ring engine.  The queue engine
+has storage for this many characters too, and fails a longer uxQueueLength. */
+#define serRX_RING_SIZE					( 128 )
+#define serTX_RING_SIZE					( 128 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -89,66 +152,186 @@ extern void vUART_ISREntry( void );
  */
 void vUART_ISRHandler( void );
 
+/*
+ * Configure UART1 and the VIC.  Common to both engines.
+ */
+static void prvSetupUART( unsigned long ulWantedBaud );
+
 /*-----------------------------------------------------------*/
 
+/* The only port this driver supports. */
+typedef struct SERIAL_UART
+{
+	unsigned long ulBase;
+} xSerialUART;
+
+static const xSerialUART xUART1 = { serUART1_BASE };
+
+/* Communication flag between the interrupt service routine and serial API. */
+static volatile long lTHREEmpty;
+
+#if serUSE_RING_BUFFERS == 1
+
+/* A single producer/single consumer ring.  uxHead is only written by the 
+producer and uxTail only by the consumer.  Both are free running and wrapped
+with uxMask when the buffer is accessed, so the ring holds uxMask + 1 
+characters. */
+typedef struct SERIAL_RING
+{
+	volatile unsigned portBASE_TYPE uxHead;
+	volatile unsigned portBASE_TYPE uxTail;
+	unsigned portBASE_TYPE uxMask;
+	signed char *pcBuffer;
+} xSerialRing;
+
+static signed char cRxStorage[ serRX_RING_SIZE ];
+static signed char cTxStorage[ serTX_RING_SIZE ];
+
+static xSerialRing xRxRing = { 0, 0, serRX_RING_SIZE - 1, cRxStorage };
+static xSerialRing xTxRing = { 0, 0, serTX_RING_SIZE - 1, cTxStorage };
+
+/* Tasks blocked waiting for a character to arrive or for space in the Tx 
+ring, or NULL if no task is waiting.  Written by the task side only, the ISR
+just notifies whichever task is recorded. */
+static TaskHandle_t volatile xRxWaitingTask = NULL;
+static TaskHandle_t volatile xTxWaitingTask = NULL;
+
+/*
+ * Write/read one character to/from a ring.  Return pdFALSE if the ring is
+ * full/empty.  prvRingPut() must only be called by the ring's producer and
+ * prvRingGet() by its consumer.
+ */
+static portBASE_TYPE prvRingPut( xSerialRing *pxRing, signed char cChar );
+static portBASE_TYPE prvRingGet( xSerialRing *pxRing, signed char *pcChar );
+
+#else
+
 /* Queues used to hold received characters, and characters waiting to be
 transmitted. */
 static QueueHandle_t xRxedChars; 
 static QueueHandle_t xCharsForTx; 
 
-/* Communication flag between the interrupt service routine and serial API. */
-static volatile long lTHREEmpty;
+/* Their storage, when the application creates everything statically.  The
+Tx queue is one longer than asked for. */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	static signed char cRxStorage[ serRX_RING_SIZE ];
+	static signed char cTxStorage[ serTX_RING_SIZE + 1 ];
+	static StaticQueue_t xRxQueueBuffer;
+	static StaticQueue_t xTxQueueBuffer;
+#endif
+
+#endif /* serUSE_RING_BUFFERS */
 
 /*-----------------------------------------------------------*/
 
-xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength )
+static void prvSetupUART( unsigned long ulWantedBaud )
 {
 unsigned long ulDivisor, ulWantedClock;
-xComPortHandle xReturn = serHANDLE;
 
-	/* Create the queues used to hold Rx and Tx characters. */
-	xRxedChars = xQueueCreate( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
-	xCharsForTx = xQueueCreate( uxQueueLength + 1, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
+	portENTER_CRITICAL()
+	{
+		/* Setup the baud rate:  Calculate the divisor value. */
+		ulWantedClock = ulWantedBaud * serWANTED_CLOCK_SCALING;
+		ulDivisor = configCPU_CLOCK_HZ / ulWantedClock;
 
-	/* Initialise the THRE empty flag. */
-	lTHREEmpty = pdTRUE;
+		/* Set the DLAB bit so we can access the divisor. */
+		serU1WRITE( serLCR, serU1READ( serLCR ) | serDLAB );
 
-	if( 
-		( xRxedChars != serINVALID_QUEUE ) && 
-		( xCharsForTx != serINVALID_QUEUE ) && 
-		( ulWantedBaud != ( unsigned long ) 0 ) 
-	  )
+		/* Setup the divisor. */
+		serU1WRITE( serDLL, ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff ) );
+		ulDivisor >>= 8;
+		serU1WRITE( serDLM, ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff ) );
+
+		/* Turn on the FIFO's, clear the buffers and set the Rx trigger
+		level. */
+		serU1WRITE( serFCR, ( serFIFO_ON | serCLEAR_FIFO | serFCR_RX_TRIGGER_LEVEL ) );
+
+		/* Setup transmission format. */
+		serU1WRITE( serLCR, serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS );
+
+		/* Setup the VIC for the UART. */
+		VICIntSelect &= ~( serU1VIC_CHANNEL_BIT );
+		VICIntEnable |= serU1VIC_CHANNEL_BIT;
+		VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
+		VICVectCntl1 = serU1VIC_CHANNEL | serU1VIC_ENABLE;
+
+		/* Enable UART0 interrupts. */
+		serU1WRITE( serIER, serU1READ( serIER ) | serENABLE_INTERRUPTS );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength )
+{
+signed char *pxNext;
+
+	/* NOTE: This implementation does not handle the queue being full as no
+	block time is used! */
+
+	/* The port handle is not required as this driver only supports UART0. */
+	( void ) pxPort;
+	( void ) usStringLength;
+
+	/* Send each character in the string, one at a time. */
+	pxNext = ( signed char * ) pcString;
+	while( *pxNext )
 	{
-		portENTER_CRITICAL()
-		{
-			/* Setup the baud rate:  Calculate the divisor value. */
-			ulWantedClock = ulWantedBaud * serWANTED_CLOCK_SCALING;
-			ulDivisor = configCPU_CLOCK_HZ / ulWantedClock;
+		xSerialPutChar( pxPort, *pxNext, serNO_BLOCK );
+		pxNext++;
+	}
+}
+/*-----------------------------------------------------------*/
 
-			/* Set the DLAB bit so we can access the divisor. */
-			U1LCR |= serDLAB;
+#if serUSE_RING_BUFFERS == 1
 
-			/* Setup the divisor. */
-			U1DLL = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
-			ulDivisor >>= 8;
-			U1DLM = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
+static portBASE_TYPE prvRingPut( xSerialRing *pxRing, signed char cChar )
+{
+unsigned portBASE_TYPE uxHead = pxRing->uxHead;
 
-			/* Turn on the FIFO's and clear the buffers. */
-			U1FCR = ( serFIFO_ON | serCLEAR_FIFO );
+	if( ( uxHead - pxRing->uxTail ) > pxRing->uxMask )
+	{
+		return pdFALSE;
+	}
 
-			/* Setup transmission format. */
-			U1LCR = serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS;
+	/* Store the character before publishing the new head so the consumer
+	never sees a slot that has not been written yet. */
+	pxRing->pcBuffer[ uxHead & pxRing->uxMask ] = cChar;
+	pxRing->uxHead = uxHead + 1;
 
-			/* Setup the VIC for the UART. */
-			VICIntSelect &= ~( serU1VIC_CHANNEL_BIT );
-			VICIntEnable |= serU1VIC_CHANNEL_BIT;
-			VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
-			VICVectCntl1 = serU1VIC_CHANNEL | serU1VIC_ENABLE;
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
 
-			/* Enable UART0 interrupts. */
-			U1IER |= serENABLE_INTERRUPTS;
-		}
-		portEXIT_CRITICAL();
+static portBASE_TYPE prvRingGet( xSerialRing *pxRing, signed char *pcChar )
+{
+unsigned portBASE_TYPE uxTail = pxRing->uxTail;
+
+	if( uxTail == pxRing->uxHead )
+	{
+		return pdFALSE;
+	}
+
+	*pcChar = pxRing->pcBuffer[ uxTail & pxRing->uxMask ];
+	pxRing->uxTail = uxTail + 1;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength )
+{
+xComPortHandle xReturn = serHANDLE;
+
+	/* The rings are statically sized. */
+	( void ) uxQueueLength;
+
+	/* Initialise the THRE empty flag. */
+	lTHREEmpty = pdTRUE;
+
+	if( ulWantedBaud != ( unsigned long ) 0 )
+	{
+		prvSetupUART( ulWantedBaud );
 	}
 	else
 	{
@@ -161,39 +344,222 @@ xComPortHandle xReturn = serHANDLE;
 
 signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar, TickType_t xBlockTime )
 {
+TimeOut_t xTimeOut;
+
 	/* The port handle is not required as this driver only supports UART0. */
 	( void ) pxPort;
 
-	/* Get the next character from the buffer.  Return false if no characters
+	vTaskSetTimeOutState( &xTimeOut );
+
+	/* Get the next character from the ring.  Return false if no characters
 	are available, or arrive before xBlockTime expires. */
-	if( xQueueReceive( xRxedChars, pcRxedChar, xBlockTime ) )
+	while( prvRingGet( &xRxRing, pcRxedChar ) == pdFALSE )
 	{
-		return pdTRUE;
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			return pdFALSE;
+		}
+
+		/* Register for a notification from the ISR, then check the ring 
+		again in case a character arrived before the ISR could see the
+		registration. */
+		xRxWaitingTask = xTaskGetCurrentTaskHandle();
+
+		if( xRxRing.uxTail == xRxRing.uxHead )
+		{
+			ulTaskNotifyTake( pdTRUE, xBlockTime );
+		}
+
+		xRxWaitingTask = NULL;
 	}
-	else
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed char cOutChar, TickType_t xBlockTime )
+{
+TimeOut_t xTimeOut;
+
+	/* The port handle is not required as this driver only supports UART0. */
+	( void ) pxPort;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	while( prvRingPut( &xTxRing, cOutChar ) == pdFALSE )
 	{
-		return pdFALSE;
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			return pdFAIL;
+		}
+
+		/* Wait for the ISR to make space, using the same register then
+		re-check sequence as xSerialGetChar(). */
+		xTxWaitingTask = xTaskGetCurrentTaskHandle();
+
+		if( ( xTxRing.uxHead - xTxRing.uxTail ) > xTxRing.uxMask )
+		{
+			ulTaskNotifyTake( pdTRUE, xBlockTime );
+		}
+
+		xTxWaitingTask = NULL;
+	}
+
+	/* If the THRE is empty the ISR is not transmitting and will not run
+	again until something is written to U1THR, so this task can safely act
+	as the consumer to start the transmission off.  Otherwise the character
+	will be sent by the ISR once those ahead of it have gone. */
+	if( lTHREEmpty == ( long ) pdTRUE )
+	{
+		lTHREEmpty = pdFALSE;
+		prvRingGet( &xTxRing, &cOutChar );
+		serU1WRITE( serTHR, cOutChar );
 	}
+
+	return pdPASS;
 }
 /*-----------------------------------------------------------*/
 
-void vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength )
+void vUART_ISRHandler( void )
 {
-signed char *pxNext;
+signed char cChar;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+unsigned char ucInterrupt;
+unsigned portBASE_TYPE uxCount;
 
-	/* NOTE: This implementation does not handle the queue being full as no
-	block time is used! */
+	ucInterrupt = serU1READ( serIIR );
+
+	/* The interrupt pending bit is active low. */
+	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
+	{
+		/* What caused the interrupt? */
+		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
+		{
+			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
+									cChar = serU1READ( serLSR );
+									break;
+	
+			case serSOURCE_THRE	:	/* The Tx FIFO is empty.  Refill it with
+									as many characters from the Tx ring as
+									it will take. */
+									for( uxCount = 0; uxCount < serTX_FIFO_LENGTH; uxCount++ )
+									{
+										if( prvRingGet( &xTxRing, &cChar ) == pdFALSE )
+										{
+											break;
+										}
+
+										serU1WRITE( serTHR, cChar );
+									}
+
+									if( uxCount == 0 )
+									{
+										/* There are no further characters 
+										queued to send so we can indicate 
+										that the THRE is available. */
+										lTHREEmpty = pdTRUE;
+									}
+									else if( xTxWaitingTask != NULL )
+									{
+										vTaskNotifyGiveFromISR( xTxWaitingTask, &xHigherPriorityTaskWoken );
+									}
+									break;
+	
+			case serSOURCE_RX_TIMEOUT :
+			case serSOURCE_RX	:	/* Characters were received.  Move
+									everything in the Rx FIFO to the Rx 
+									ring.  Characters are dropped if the
+									ring is full. */
+									while( ( serU1READ( serLSR ) & serDATA_READY ) != 0 )
+									{
+										cChar = serU1READ( serRBR );
+										prvRingPut( &xRxRing, cChar );
+									}
+
+									if( xRxWaitingTask != NULL )
+									{
+										vTaskNotifyGiveFromISR( xRxWaitingTask, &xHigherPriorityTaskWoken );
+									}
+									break;
+	
+			default				:	/* There is nothing to do, leave the ISR. */
+									break;
+		}
+
+		ucInterrupt = serU1READ( serIIR );
+	}
+
+	/* Clear the ISR in the VIC. */
+	VICVectAddr = serCLEAR_VIC_INTERRUPT;
+
+	/* Exit the ISR.  If a task was woken by either a character being received
+	or transmitted then a context switch will occur. */
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
 
+#else /* serUSE_RING_BUFFERS */
+
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength )
+{
+xComPortHandle xReturn = serHANDLE;
+
+	/* Create the queues used to hold Rx and Tx characters, if there is room
+	for them. */
+	if( ( uxQueueLength > ( unsigned portBASE_TYPE ) 0 ) && ( uxQueueLength <= ( unsigned portBASE_TYPE ) serRX_RING_SIZE ) && ( uxQueueLength <= ( unsigned portBASE_TYPE ) serTX_RING_SIZE ) )
+	{
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			xRxedChars = xQueueCreateStatic( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( signed char ), ( uint8_t * ) cRxStorage, &xRxQueueBuffer );
+			xCharsForTx = xQueueCreateStatic( uxQueueLength + 1, ( unsigned portBASE_TYPE ) sizeof( signed char ), ( uint8_t * ) cTxStorage, &xTxQueueBuffer );
+		}
+		#else
+		{
+			xRxedChars = xQueueCreate( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
+			xCharsForTx = xQueueCreate( uxQueueLength + 1, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
+		}
+		#endif
+	}
+	else
+	{
+		xRxedChars = serINVALID_QUEUE;
+		xCharsForTx = serINVALID_QUEUE;
+	}
+
+	/* Initialise the THRE empty flag. */
+	lTHREEmpty = pdTRUE;
+
+	if( 
+		( xRxedChars != serINVALID_QUEUE ) && 
+		( xCharsForTx != serINVALID_QUEUE ) && 
+		( ulWantedBaud != ( unsigned long ) 0 ) 
+	  )
+	{
+		prvSetupUART( ulWantedBaud );
+	}
+	else
+	{
+		xReturn = ( xComPortHandle ) 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar, TickType_t xBlockTime )
+{
 	/* The port handle is not required as this driver only supports UART0. */
 	( void ) pxPort;
-	( void ) usStringLength;
 
-	/* Send each character in the string, one at a time. */
-	pxNext = ( signed char * ) pcString;
-	while( *pxNext )
+	/* Get the next character from the buffer.  Return false if no characters
+	are available, or arrive before xBlockTime expires. */
+	if( xQueueReceive( xRxedChars, pcRxedChar, xBlockTime ) )
 	{
-		xSerialPutChar( pxPort, *pxNext, serNO_BLOCK );
-		pxNext++;
+		return pdTRUE;
+	}
+	else
+	{
+		return pdFALSE;
 	}
 }
 /*-----------------------------------------------------------*/
@@ -213,7 +579,7 @@ signed portBASE_TYPE xReturn;
 			/* We wrote the character directly to the UART, so was 
 			successful. */
 			lTHREEmpty = pdFALSE;
-			U1THR = cOutChar;
+			serU1WRITE( serTHR, cOutChar );
 			xReturn = pdPASS;
 		}
 		else 
@@ -232,7 +598,7 @@ signed portBASE_TYPE xReturn;
 			{
 				xQueueReceive( xCharsForTx, &cOutChar, serNO_BLOCK );
 				lTHREEmpty = pdFALSE;
-				U1THR = cOutChar;
+				serU1WRITE( serTHR, cOutChar );
 			}
 		}
 	}
@@ -247,8 +613,9 @@ void vUART_ISRHandler( void )
 signed char cChar;
 portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 unsigned char ucInterrupt;
+unsigned portBASE_TYPE uxCount;
 
-	ucInterrupt = U1IIR;
+	ucInterrupt = serU1READ( serIIR );
 
 	/* The interrupt pending bit is active low. */
 	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
@@ -257,16 +624,23 @@ unsigned char ucInterrupt;
 		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
 		{
 			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
-									cChar = U1LSR;
+									cChar = serU1READ( serLSR );
 									break;
 	
-			case serSOURCE_THRE	:	/* The THRE is empty.  If there is another
-									character in the Tx queue, send it now. */
-									if( xQueueReceiveFromISR( xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
+			case serSOURCE_THRE	:	/* The Tx FIFO is empty.  Refill it with
+									as many characters from the Tx queue as
+									it will take. */
+									for( uxCount = 0; uxCount < serTX_FIFO_LENGTH; uxCount++ )
 									{
-										U1THR = cChar;
+										if( xQueueReceiveFromISR( xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) != pdTRUE )
+										{
+											break;
+										}
+
+										serU1WRITE( serTHR, cChar );
 									}
-									else
+
+									if( uxCount == 0 )
 									{
 										/* There are no further characters 
 										queued to send so we can indicate 
@@ -276,17 +650,21 @@ unsigned char ucInterrupt;
 									break;
 	
 			case serSOURCE_RX_TIMEOUT :
-			case serSOURCE_RX	:	/* A character was received.  Place it in 
-									the queue of received characters. */
-									cChar = U1RBR;
-									xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+			case serSOURCE_RX	:	/* Characters were received.  Place
+									everything in the Rx FIFO in the queue
+									of received characters. */
+									while( ( serU1READ( serLSR ) & serDATA_READY ) != 0 )
+									{
+										cChar = serU1READ( serRBR );
+										xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+									}
 									break;
 	
 			default				:	/* There is nothing to do, leave the ISR. */
 									break;
 		}
 
-		ucInterrupt = U1IIR;
+		ucInterrupt = serU1READ( serIIR );
 	}
 
 	/* Clear the ISR in the VIC. */
@@ -298,9 +676,4 @@ unsigned char ucInterrupt;
 }
 /*-----------------------------------------------------------*/
 
-
-
-
-
-
-	
+#endif /* serUSE_RING_BUFFERS */
@@ -35,8 +35,13 @@
 	;finishes off by	restoring the context of whichever task is now selected to
 	;enter the RUNNING state (which might now be a different task to that which
 	;was originally interrupted.
+	;
+	;vUART0_ISREntry does the same for UART0.  Its handler is only provided by
+	;the multi-port driver, so it is imported weakly.
 	IMPORT vUART_ISRHandler
+	IMPORT vUART0_ISRHandler [WEAK]
 	EXPORT vUART_ISREntry
+	EXPORT vUART0_ISREntry
 
 	;/* Interrupt entry must always be in ARM mode. */
 	ARM
@@ -60,4 +65,20 @@ vUART_ISREntry
 	; interrupted.
 	portRESTORE_CONTEXT
 
+
+vUART0_ISREntry
+
+	PRESERVE8
+
+	; Save the context of the interrupted task.
+	portSAVE_CONTEXT
+
+	; Call the C handler function - defined within serial.c.
+	LDR R0, =vUART0_ISRHandler
+	MOV LR, PC
+	BX R0
+
+	; Restore the context of the task selected to run next.
+	portRESTORE_CONTEXT
+
 	END
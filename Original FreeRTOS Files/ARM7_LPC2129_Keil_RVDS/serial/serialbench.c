@@ -0,0 +1,222 @@
+/*
+ * FreeRTOS V202012.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Throughput and CPU cost benchmark for the UART1 driver in serial.c.
+ *
+ * Build the project once with serUSE_RING_BUFFERS set to 1 (ring engine) and 
+ * once with it set to 0 (queue engine) to compare the two.
+ *
+ * Benchmarks/Serial Engines holds the application that runs it, and the host
+ * build has a target for each engine, "make sbench-queue sbench-ring".  No 
+ * figures have been taken with it yet, so serial.c keeps the queue engine as
+ * its default.
+ *
+ * Three tasks are created:
+ *
+ * The "Spin" task runs at the idle priority and does nothing but increment a
+ * counter.  The number of increments it manages in a fixed window is a 
+ * measure of the CPU time left over by everything else.
+ *
+ * The "SerRx" task blocks on xSerialGetChar() and counts what it receives.  It
+ * only sees characters if the UART1 Tx pin is looped back to the Rx pin.
+ *
+ * The "SerTx" task first measures the spin count of an idle window, then
+ * keeps the transmitter saturated for another window of the same length
+ * and reports a line in this format:
+ *
+ *     engine=ring tx=11520 rx=11520 cpu=123
+ *
+ * where tx and rx are bytes per second and cpu is the share of the CPU, in
+ * tenths of a percent, consumed by the driver (task side and ISR) to keep
+ * that rate up.  The report is sent over the port under test between runs.
+ *
+ * The measurement relies on the spin task getting all of the otherwise idle
+ * time, so the scheduler must be preemptive.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "strfmt.h"
+#include "serialbench.h"
+
+/* Must match the setting used by serial.c. */
+#ifndef serUSE_RING_BUFFERS
+	#define serUSE_RING_BUFFERS			0
+#endif
+
+#define benchSTACK_SIZE				configMINIMAL_STACK_SIZE
+#define benchQUEUE_LENGTH			( 128 )
+#define benchWINDOW_TICKS			( ( TickType_t ) 1000 / portTICK_PERIOD_MS )
+#define benchWINDOWS_PER_SECOND		( 1000UL / ( benchWINDOW_TICKS * portTICK_PERIOD_MS ) )
+#define benchREPORT_LENGTH			( 64 )
+#define benchFIRST_CHAR				( ( signed char ) 'A' )
+#define benchLAST_CHAR				( ( signed char ) 'Z' )
+
+#if serUSE_RING_BUFFERS == 1
+	#define benchENGINE_NAME		"ring"
+#else
+	#define benchENGINE_NAME		"queue"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void vSpinTask( void *pvParameters );
+static void vSerialRxTask( void *pvParameters );
+static void vSerialTxTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xComPortHandle xPort = NULL;
+static unsigned long ulBaudRate;
+
+/* Incremented by the spin task and the Rx task respectively. */
+static volatile unsigned long ulSpinCount = 0;
+static volatile unsigned long ulRxCount = 0;
+
+/* Stacks and TCBs of the spin, Rx and Tx tasks. */
+static StackType_t xSpinStack[ benchSTACK_SIZE ], xRxStack[ benchSTACK_SIZE ], xTxStack[ benchSTACK_SIZE ];
+static StaticTask_t xSpinTCB, xRxTCB, xTxTCB;
+
+/*-----------------------------------------------------------*/
+
+void vStartSerialBenchTasks( unsigned portBASE_TYPE uxPriority, unsigned long ulWantedBaud )
+{
+	ulBaudRate = ulWantedBaud;
+	xPort = xSerialPortInitMinimal( ulBaudRate, benchQUEUE_LENGTH );
+
+	xTaskCreateStatic( vSpinTask, "Spin", benchSTACK_SIZE, NULL, tskIDLE_PRIORITY, xSpinStack, &xSpinTCB );
+	xTaskCreateStatic( vSerialRxTask, "SerRx", benchSTACK_SIZE, NULL, uxPriority, xRxStack, &xRxTCB );
+	xTaskCreateStatic( vSerialTxTask, "SerTx", benchSTACK_SIZE, NULL, uxPriority, xTxStack, &xTxTCB );
+}
+/*-----------------------------------------------------------*/
+
+static void vSpinTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulSpinCount++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vSerialRxTask( void *pvParameters )
+{
+signed char cRxedChar;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSerialGetChar( xPort, &cRxedChar, portMAX_DELAY ) == pdTRUE )
+		{
+			ulRxCount++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void vSerialTxTask( void *pvParameters )
+{
+TickType_t xWindowEnd;
+unsigned long ulIdleSpins, ulBusySpins, ulTxCount, ulRxAtStart, ulCost;
+signed char cChar = benchFIRST_CHAR;
+char cReport[ benchREPORT_LENGTH ], *pcNext;
+
+	( void ) pvParameters;
+
+	/* Measure how much the spin task gets done when the port is idle. */
+	vTaskDelay( 1 );
+	ulIdleSpins = ulSpinCount;
+	vTaskDelay( benchWINDOW_TICKS );
+	ulIdleSpins = ulSpinCount - ulIdleSpins;
+
+	/* Scale so the cost below comes out in tenths of a percent. */
+	ulIdleSpins /= 1000UL;
+	if( ulIdleSpins == 0UL )
+	{
+		ulIdleSpins = 1UL;
+	}
+
+	for( ;; )
+	{
+		/* Keep the transmitter saturated for one window.  xSerialPutChar()
+		blocks whenever the Tx buffer is full, so the number of characters 
+		accepted settles at the line rate. */
+		ulTxCount = 0UL;
+		ulRxAtStart = ulRxCount;
+		vTaskDelay( 1 );
+		ulBusySpins = ulSpinCount;
+		xWindowEnd = xTaskGetTickCount() + benchWINDOW_TICKS;
+
+		while( ( long ) ( xWindowEnd - xTaskGetTickCount() ) > 0L )
+		{
+			if( xSerialPutChar( xPort, cChar, benchWINDOW_TICKS ) == pdPASS )
+			{
+				ulTxCount++;
+
+				if( cChar == benchLAST_CHAR )
+				{
+					cChar = benchFIRST_CHAR;
+				}
+				else
+				{
+					cChar++;
+				}
+			}
+		}
+
+		ulBusySpins = ulSpinCount - ulBusySpins;
+
+		ulCost = ulBusySpins / ulIdleSpins;
+		ulCost = ( ulCost < 1000UL ) ? ( 1000UL - ulCost ) : 0UL;
+
+		/* Let the window's characters drain before reporting so the report
+		is not interleaved with the test pattern. */
+		vTaskDelay( benchWINDOW_TICKS );
+
+		pcNext = pcStrFmtAppendString( cReport, "\r\nengine=" benchENGINE_NAME " tx=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulTxCount * benchWINDOWS_PER_SECOND );
+		pcNext = pcStrFmtAppendString( pcNext, " rx=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ( ulRxCount - ulRxAtStart ) * benchWINDOWS_PER_SECOND );
+		pcNext = pcStrFmtAppendString( pcNext, " cpu=" );
+		pcNext = pcStrFmtAppendNumber( pcNext, ulCost );
+		pcNext = pcStrFmtAppendString( pcNext, "\r\n" );
+
+		vSerialPutString( xPort, ( signed char * ) cReport, ( unsigned short ) ( pcNext - cReport ) );
+		vTaskDelay( benchWINDOW_TICKS );
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Decode the binary log stream written by Starter_Files_V0/source/binlog.c.
+
+The message table is read from the binlog_ids.h the target was built with, so
+the two always agree on IDs and formats.  Usage:
+
+    stty -F /dev/ttyUSB0 115200 raw
+    binlog_decode.py Starter_Files_V0/header/binlog_ids.h /dev/ttyUSB0
+
+The input can be any file, or - for stdin.  Each decoded record is printed as
+
+    <tick> <message>
+
+Frames with a bad checksum are skipped and the decoder resynchronises on the
+next sync byte.
+"""
+
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+ROW = re.compile(r'^\s*X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+CONVERSION = re.compile(r'%(?:l{0,2})([duxXc%])')
+
+
+def load_messages(path):
+    """Return the list of (name, format) rows, indexed by message ID."""
+    messages = []
+    with open(path, encoding='ascii') as header:
+        for line in header:
+            match = ROW.match(line)
+            if match:
+                messages.append((match.group(1), match.group(2)))
+    if not messages:
+        sys.exit('no message rows found in ' + path)
+    return messages
+
+
+def format_message(fmt, args):
+    """Apply a printf style format to the raw 32 bit arguments."""
+    values = iter(args)
+
+    def convert(match):
+        kind = match.group(1)
+        if kind == '%':
+            return '%'
+        value = next(values, 0)
+        if kind == 'd':
+            return str(struct.unpack('<i', struct.pack('<I', value))[0])
+        if kind == 'u':
+            return str(value)
+        if kind == 'x':
+            return '%x' % value
+        if kind == 'X':
+            return '%X' % value
+        return chr(value & 0xFF)
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def frames(stream):
+    """Yield (id, tick, args) for every frame with a good checksum."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buffer.extend(chunk)
+
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                del buffer[:]
+                break
+            del buffer[:start]
+
+            if len(buffer) < 3:
+                break
+            count = buffer[2]
+            if count > 4:
+                del buffer[:1]
+                continue
+
+            length = 3 + 4 + (4 * count) + 1
+            if len(buffer) < length:
+                break
+
+            frame = bytes(buffer[:length])
+            if sum(frame[1:]) & 0xFF != 0:
+                # Not a real frame start, look for the next sync byte.
+                del buffer[:1]
+                continue
+
+            del buffer[:length]
+            words = struct.unpack('<%dI' % (count + 1), frame[3:-1])
+            yield frame[1], words[0], words[1:]
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit('usage: binlog_decode.py binlog_ids.h <file|->')
+
+    messages = load_messages(argv[1])
+
+    if argv[2] == '-':
+        stream = sys.stdin.buffer
+    else:
+        stream = open(argv[2], 'rb', buffering=0)
+
+    for message_id, tick, args in frames(stream):
+        if message_id < len(messages):
+            text = format_message(messages[message_id][1], args)
+        else:
+            text = 'unknown message %u %s' % (message_id, list(args))
+        print('%10u %s' % (tick, text), flush=True)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Host side of the SLIP + CRC16 framing in Starter_Files_V0/source/slip.c.
+
+    slip.py encode [in] [out]   frame each line of the input as one packet
+    slip.py decode [in] [out]   print the payload of each good packet
+    slip.py bench [size] [baud] measure host encode/decode speed and the
+                                payload rate the framing leaves at a baud rate
+
+in and out default to stdin and stdout, so a serial port (set up with
+stty ... raw) can be used for either.  As on the target, a packet is framed as
+END, payload, CRC high, CRC low, END, with END and ESC escaped as in RFC 1055.
+The CRC is CRC-16/CCITT (polynomial 0x1021, initial value 0xffff).
+"""
+
+import os
+import sys
+import time
+
+END = 0xC0
+ESC = 0xDB
+ESC_END = 0xDC
+ESC_ESC = 0xDD
+
+_CRC_TABLE = []
+for _byte in range(256):
+    _crc = _byte << 8
+    for _ in range(8):
+        _crc = ((_crc << 1) ^ 0x1021) if (_crc & 0x8000) else (_crc << 1)
+    _CRC_TABLE.append(_crc & 0xFFFF)
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT of data, continuing from crc."""
+    for byte in data:
+        crc = ((crc << 8) & 0xFFFF) ^ _CRC_TABLE[(crc >> 8) ^ byte]
+    return crc
+
+
+def encode(payload):
+    """Return the complete frame for one packet."""
+    crc = crc16(payload)
+    body = bytes(payload) + bytes((crc >> 8, crc & 0xFF))
+    body = body.replace(bytes((ESC,)), bytes((ESC, ESC_ESC)))
+    body = body.replace(bytes((END,)), bytes((ESC, ESC_END)))
+    return bytes((END,)) + body + bytes((END,))
+
+
+class Decoder:
+    """Incremental decoder, fed any number of bytes at a time."""
+
+    def __init__(self, max_payload=1024):
+        self.max_length = max_payload + 2
+        self.packets = 0
+        self.crc_errors = 0
+        self.overflows = 0
+        self._frame = bytearray()
+        self._escaped = False
+        self._discarding = False
+
+    def feed(self, data):
+        """Yield the payload of every good packet completed by data."""
+        for byte in data:
+            if byte == END:
+                frame, discarding = self._frame, self._discarding
+                self._frame = bytearray()
+                self._escaped = False
+                self._discarding = False
+                if discarding:
+                    self.overflows += 1
+                elif frame:
+                    if len(frame) > 2 and crc16(frame) == 0:
+                        self.packets += 1
+                        yield bytes(frame[:-2])
+                    else:
+                        self.crc_errors += 1
+            elif byte == ESC:
+                self._escaped = True
+            elif not self._discarding:
+                if self._escaped:
+                    byte = {ESC_END: END, ESC_ESC: ESC}.get(byte, byte)
+                    self._escaped = False
+                if len(self._frame) < self.max_length:
+                    self._frame.append(byte)
+                else:
+                    self._discarding = True
+
+
+def _open(argv, index, mode):
+    if len(argv) > index and argv[index] != '-':
+        return open(argv[index], mode, buffering=0)
+    return sys.stdin.buffer if 'r' in mode else sys.stdout.buffer
+
+
+def _encode(argv):
+    source, sink = _open(argv, 2, 'rb'), _open(argv, 3, 'wb')
+    for line in source:
+        sink.write(encode(line.rstrip(b'\r\n')))
+        sink.flush()
+
+
+def _decode(argv):
+    source, sink = _open(argv, 2, 'rb'), _open(argv, 3, 'wb')
+    decoder = Decoder()
+    while True:
+        chunk = source.read(1) if source.isatty() else source.read(4096)
+        if not chunk:
+            break
+        for payload in decoder.feed(chunk):
+            sink.write(payload + b'\n')
+            sink.flush()
+    sys.stderr.write('packets=%d crc_errors=%d overflows=%d\n'
+                     % (decoder.packets, decoder.crc_errors, decoder.overflows))
+
+
+def _bench(argv):
+    size = int(argv[2]) if len(argv) > 2 else 64
+    baud = int(argv[3]) if len(argv) > 3 else 115200
+    count = max(1, 2000000 // size)
+    payloads = [os.urandom(size) for _ in range(64)]
+
+    start = time.perf_counter()
+    frames = [encode(payloads[i % 64]) for i in range(count)]
+    encode_time = time.perf_counter() - start
+
+    stream = b''.join(frames)
+    decoder = Decoder(size)
+    start = time.perf_counter()
+    decoded = sum(1 for _ in decoder.feed(stream))
+    decode_time = time.perf_counter() - start
+
+    payload_bytes = size * count
+    overhead = len(stream) / payload_bytes
+    # 8N1 puts 10 bits on the line per byte.
+    line_rate = baud / 10.0
+
+    print('payload %d bytes x %d packets, %d decoded, %d crc errors'
+          % (size, count, decoded, decoder.crc_errors))
+    print('host encode %.2f MB/s, decode %.2f MB/s'
+          % (payload_bytes / encode_time / 1e6, payload_bytes / decode_time / 1e6))
+    print('wire bytes per payload byte %.3f, payload rate at %d baud %.0f bytes/s'
+          % (overhead, baud, line_rate / overhead))
+
+
+def main(argv):
+    commands = {'encode': _encode, 'decode': _decode, 'bench': _bench}
+    if len(argv) < 2 or argv[1] not in commands:
+        sys.exit(__doc__)
+    commands[argv[1]](argv)
+
+
+if __name__ == '__main__':
+    main(sys.argv)